@@ -0,0 +1,339 @@
+/**********************************************************************************
+ * FILE:            benchmark.cpp
+ * DESCRIPTION:     This program generates synthetic graphs and times every
+ *                  shortest path and spanning tree algorithm of the repository
+ *                  on them, including the sortQueue() Dijkstra loop of the
+ *                  original exercises as a baseline. It prints one CSV row per
+ *                  graph and algorithm:
+ *                      generator,vertices,edges,algorithm,seconds,
+ *                      edges_per_second,peak_rss_kb,cache_misses_per_arc,
+ *                      checksum
+ *                  seconds is the best of --repeat runs, and peak_rss_kb the
+ *                  peak resident memory of a process that only builds the graph
+ *                  and runs that algorithm. cache_misses_per_arc divides the
+ *                  cache misses of the fastest run, as counted by the processor,
+ *                  by the number of arcs, which a search reaching every vertex
+ *                  relaxes once each; it is -1 where the counters cannot be read.
+ *                  --shuffle numbers the vertices at random, as real data
+ *                  comes, and --order renumbers them for locality (reorder.h)
+ *                  before any algorithm runs. The *_int rows run on the weights
+ *                  quantized to thousandths, as distances, to compare the
+ *                  integer queues with the heap. The queries_int rows answer
+ *                  many point-to-point queries with one reused search
+ *                  workspace, as QueryServer does, on weights quantized to
+ *                  millionths, so that a queue whose cost per query grows with
+ *                  its number of buckets shows. The checksum (sum of the safety
+ *                  or distance of every node, or tree cost) must agree between
+ *                  variants.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+// time the algorithms with the counters of trace.h compiled out, unless asked for
+#ifndef TRACE_LEVEL
+#define TRACE_LEVEL 0
+#endif
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "../../common/csr_graph.h"
+#include "../../common/dijkstra.h"
+#include "../../common/delta_stepping.h"
+#include "../../common/mst.h"
+#include "../../common/filter_kruskal.h"
+#include "../../common/boruvka.h"
+#include "../../common/generators.h"
+#include "../../common/reorder.h"
+#include "../../common/integer_queues.h"
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#endif
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+using namespace std;
+
+/*** Outcome of one measurement. peak_rss_kb and cache_misses are -1 where they cannot be measured. ***/
+struct measurement {
+	double seconds;
+	double checksum;
+	long peak_rss_kb;
+	long long cache_misses;
+};
+
+/*** cache_counter counts the cache misses of this thread between start() and stop(), which
+returns -1 if the system does not give access to the counter. ***/
+class cache_counter {
+public:
+	cache_counter() {
+#ifdef __linux__
+		perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.config = PERF_COUNT_HW_CACHE_MISSES;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+	}
+	~cache_counter() {
+#ifdef __linux__
+		if (fd >= 0) close(fd);
+#endif
+	}
+
+	void start() {
+#ifdef __linux__
+		if (fd < 0) return;
+		ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+		ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+	}
+
+	long long stop() {
+#ifdef __linux__
+		if (fd < 0) return -1;
+		ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+		long long count;
+		if (read(fd, &count, sizeof(count)) == sizeof(count)) return count;
+#endif
+		return -1;
+	}
+
+private:
+	int fd = -1;
+};
+
+/*** sort_queue_dijkstra() is the loop of the original exercise 13: every node waits in a
+queue that is sorted again after each step, by descending safety function. ***/
+double sort_queue_dijkstra(const csr_graph& g, int s) {
+	int V = g.num_vertices();
+	vector <double> saf(V, 0.0);
+	vector <bool> visited(V, false);
+	saf[s] = 1.0;
+	queue <int> Q;
+	for (int v = 0; v < V; v++) { Q.push(v); }
+	auto sortQueue = [&]() {
+		vector <int> aux;
+		while (!Q.empty()) {
+			aux.push_back(Q.front());
+			Q.pop();
+		}
+		sort(aux.begin(), aux.end(), [&](int a, int b) { return saf[a] > saf[b]; });
+		for (int i = 0; i < aux.size(); i++) { Q.push(aux[i]); }
+	};
+	sortQueue();
+	while (!Q.empty()) {
+		int u = Q.front();
+		Q.pop();
+		visited[u] = true;
+		if (saf[u] == 0) break;
+		for (int64_t e = g.begin(u); e < g.end(u); e++) {
+			int v = g.targets[e];
+			if (!visited[v] && saf[v] < saf[u] * g.weights[e]) saf[v] = saf[u] * g.weights[e];
+		}
+		sortQueue();
+	}
+	double sum = 0;
+	for (int v = 0; v < V; v++) { sum += saf[v]; }
+	return sum;
+}
+
+/*** safety_sum() adds the values of a search by the safety semiring. ***/
+double safety_sum(const vector <double>& value) {
+	double sum = 0;
+	for (int v = 0; v < value.size(); v++) { sum += value[v]; }
+	return sum;
+}
+
+/*** distance_sum() adds the distances of a search, leaving out the nodes not reached. ***/
+double distance_sum(const vector <double>& value) {
+	double sum = 0;
+	for (int v = 0; v < value.size(); v++) { if (value[v] != min_sum::zero()) sum += value[v]; }
+	return sum;
+}
+
+/*** query_sum() answers queries point-to-point distance queries between pseudo-random vertices
+with a single workspace, and adds the distances found. ***/
+template <typename Queue>
+double query_sum(const csr_graph& g, int queries) {
+	sssp_workspace <min_sum, Queue> ws;
+	mt19937_64 random(12345);
+	double sum = 0;
+	for (int i = 0; i < queries; i++) {
+		int s = (int)(random() % g.num_vertices()), t = (int)(random() % g.num_vertices());
+		if (ws.run(g, s, t)) sum += ws.value(t);
+	}
+	return sum;
+}
+
+/*** forest_cost() is the cost of a spanning forest summed by ascending weight, which is the
+same for every minimum spanning forest of a graph. ***/
+double forest_cost(vector <pair <float, pair <int, int>>> F) {
+	sort(F.begin(), F.end());
+	return tree_cost(F);
+}
+
+/*** best_of() runs fn repeat times and returns the shortest time, with the cache misses of that
+run, and the last checksum. ***/
+measurement best_of(int repeat, const function <double()>& fn) {
+	measurement m = { 1e300, 0, -1, -1 };
+	cache_counter misses;
+	for (int r = 0; r < repeat; r++) {
+		misses.start();
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		m.checksum = fn();
+		double seconds = chrono::duration <double>(chrono::steady_clock::now() - start).count();
+		long long count = misses.stop();
+		if (seconds < m.seconds) {
+			m.seconds = seconds;
+			m.cache_misses = count;
+		}
+	}
+	return m;
+}
+
+/*** measure() runs best_of() in a child process, so that its peak memory can be told apart
+from that of the other algorithms. ***/
+measurement measure(int repeat, const function <double()>& fn) {
+#ifdef _WIN32
+	return best_of(repeat, fn);
+#else
+	fflush(stdout);
+	int channel[2];
+	if (pipe(channel) != 0) return best_of(repeat, fn);
+	pid_t child = fork();
+	if (child < 0) {
+		close(channel[0]);
+		close(channel[1]);
+		return best_of(repeat, fn);
+	}
+	if (child == 0) {
+		close(channel[0]);
+		measurement m = best_of(repeat, fn);
+		bool ok = write(channel[1], &m, sizeof(m)) == sizeof(m);
+		_exit(ok ? 0 : 1);
+	}
+	close(channel[1]);
+	measurement m = { -1, 0, -1, -1 };
+	bool ok = read(channel[0], &m, sizeof(m)) == sizeof(m);
+	close(channel[0]);
+	int status;
+	rusage usage;
+	if (wait4(child, &status, 0, &usage) == child && ok) m.peak_rss_kb = usage.ru_maxrss;
+	return m;
+#endif
+}
+
+/*** benchmark() runs every algorithm on one generated graph and prints their rows. ***/
+void benchmark(const string& name, const generated_graph& G, int repeat, int baseline_limit, unsigned threads) {
+	csr_graph g = to_csr(G);
+	csr_graph q = quantize_weights(g, 1000);
+	csr_graph fine = quantize_weights(g, 1000000);
+	size_t m = G.edges.size();
+	struct algorithm { string name; function <double()> run; };
+	vector <algorithm> algorithms;
+	if (G.V <= baseline_limit) algorithms.push_back({ "dijkstra_sortqueue", [&]() { return sort_queue_dijkstra(g, 0); } });
+	else cerr << name << ": dijkstra_sortqueue skipped above " << baseline_limit << " vertices" << endl;
+	algorithms.push_back({ "dijkstra_heap", [&]() { return safety_sum(dijkstra <max_product>(g, 0).value); } });
+	algorithms.push_back({ "dijkstra_batch", [&]() { return safety_sum(dijkstra_folded <max_product>(g, max_product::one(), 0).value); } });
+	algorithms.push_back({ "delta_stepping", [&]() { delta_stepping <max_product> D(g, 0, threads); return safety_sum(D.run(0)); } });
+	algorithms.push_back({ "prim_indexed", [&]() { return forest_cost(prim_mst(g)); } });
+	algorithms.push_back({ "prim_lazy", [&]() { return forest_cost(prim_lazy_mst(g)); } });
+	algorithms.push_back({ "kruskal_sort", [&]() { return forest_cost(kruskal_mst(G.V, G.edges)); } });
+	algorithms.push_back({ "kruskal_filter", [&]() { return forest_cost(filter_kruskal_mst(G.V, G.edges, threads)); } });
+	algorithms.push_back({ "boruvka", [&]() { return forest_cost(boruvka_mst(G.V, G.edges, threads)); } });
+	algorithms.push_back({ "dijkstra_int_heap", [&]() { return distance_sum(dijkstra <min_sum>(q, 0).value); } });
+	algorithms.push_back({ "dijkstra_int_radix", [&]() { return distance_sum(dijkstra <min_sum, radix_heap>(q, 0).value); } });
+	algorithms.push_back({ "dijkstra_int_bucket", [&]() { return distance_sum(dijkstra <min_sum, bucket_queue>(q, 0).value); } });
+	algorithms.push_back({ "queries_int_heap", [&]() { return query_sum <indexed_heap <double, semiring_order <min_sum>>>(fine, 256); } });
+	algorithms.push_back({ "queries_int_radix", [&]() { return query_sum <radix_heap>(fine, 256); } });
+	algorithms.push_back({ "queries_int_bucket", [&]() { return query_sum <bucket_queue>(fine, 256); } });
+	algorithms.push_back({ "prim_int_heap", [&]() { return forest_cost(prim_mst(q)); } });
+	algorithms.push_back({ "prim_int_bucket", [&]() { return forest_cost(prim_mst <bucket_queue>(q)); } });
+
+	for (int a = 0; a < algorithms.size(); a++) {
+		measurement r = measure(repeat, algorithms[a].run);
+		double per_arc = (r.cache_misses >= 0 && m > 0) ? (double)r.cache_misses / (2.0 * m) : -1.0;
+		printf("%s,%d,%zu,%s,%.6f,%.0f,%ld,%.4f,%.17g\n", name.c_str(), G.V, m, algorithms[a].name.c_str(), r.seconds,
+			r.seconds > 0 ? m / r.seconds : 0.0, r.peak_rss_kb, per_arc, r.checksum);
+		fflush(stdout);
+	}
+}
+
+/*** arrange() numbers the vertices of G at random if shuffle is set, then in the given order. ***/
+void arrange(generated_graph& G, bool shuffle, vertex_order order, unsigned long long seed) {
+	vector <int> label(G.V);
+	for (int v = 0; v < G.V; v++) { label[v] = v; }
+	if (shuffle) {
+		mt19937_64 random(seed ^ 0x9e3779b97f4a7c15ULL);
+		std::shuffle(label.begin(), label.end(), random);
+	}
+	if (order != vertex_order::none) {
+		generated_graph H = G;
+		for (int e = 0; e < H.edges.size(); e++) { H.edges[e].second = make_pair(label[H.edges[e].second.first], label[H.edges[e].second.second]); }
+		vertex_permutation P = order_vertices(to_csr(H), order);
+		for (int v = 0; v < G.V; v++) { label[v] = P.new_id[label[v]]; }
+	}
+	for (int e = 0; e < G.edges.size(); e++) { G.edges[e].second = make_pair(label[G.edges[e].second.first], label[G.edges[e].second.second]); }
+}
+
+int main(int argc, char** argv) {
+
+// arguments: [rmat|grid|geometric|complete|all] [--scale=N] [--seed=S] [--repeat=R] [--baseline-limit=V] [--threads=T]
+//            [--shuffle] [--order=none|bfs|rcm|degree]
+	string which = "all", order_name = "none";
+	int scale = 14, repeat = 3, baseline_limit = 4096;
+	unsigned long long seed = 1;
+	unsigned threads = 0;
+	bool shuffle = false;
+	for (int n = 1; n < argc; n++) {
+		string arg = argv[n];
+		if (arg.compare(0, 8, "--scale=") == 0) scale = atoi(arg.c_str() + 8);
+		else if (arg.compare(0, 7, "--seed=") == 0) seed = strtoull(arg.c_str() + 7, NULL, 10);
+		else if (arg.compare(0, 9, "--repeat=") == 0) repeat = max(1, atoi(arg.c_str() + 9));
+		else if (arg.compare(0, 17, "--baseline-limit=") == 0) baseline_limit = atoi(arg.c_str() + 17);
+		else if (arg.compare(0, 10, "--threads=") == 0) threads = atoi(arg.c_str() + 10);
+		else if (arg == "--shuffle") shuffle = true;
+		else if (arg.compare(0, 8, "--order=") == 0) order_name = arg.substr(8);
+		else which = arg;
+	}
+	if (which != "all" && which != "rmat" && which != "grid" && which != "geometric" && which != "complete") {
+		cout << "Usage: " << argv[0] << " [rmat|grid|geometric|complete|all] [--scale=N] [--seed=S] [--repeat=R] [--baseline-limit=V] [--threads=T] [--shuffle] [--order=none|bfs|rcm|degree]" << endl;
+		return 1;
+	}
+	if (scale < 2 || scale > 28) { cout << "Error: the scale must be between 2 and 28." << endl; return 1; }
+	vertex_order order;
+	try { order = parse_order(order_name); }
+	catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
+	auto run = [&](const string& name, generated_graph G) {
+		arrange(G, shuffle, order, seed);
+		benchmark(name, G, repeat, baseline_limit, threads);
+	};
+
+// every generator makes about 2^scale vertices, except the complete graph, which has 2^(scale/2 + 2)
+	printf("generator,vertices,edges,algorithm,seconds,edges_per_second,peak_rss_kb,cache_misses_per_arc,checksum\n");
+	if (which == "all" || which == "rmat") run("rmat", rmat_graph(scale, 16, seed));
+	if (which == "all" || which == "grid") {
+		int side = 1 << (scale / 2);
+		run("grid", grid_graph(side, (1 << scale) / side, seed));
+	}
+	if (which == "all" || which == "geometric") run("geometric", geometric_graph(1 << scale, 10.0, seed));
+	if (which == "all" || which == "complete") run("complete", complete_graph(1 << (scale / 2 + 2), seed));
+
+	return 0;
+}
@@ -0,0 +1,120 @@
+/**********************************************************************************
+ * FILE:            boruvka.cpp
+ * DESCRIPTION:     This program runs Boruvka's algorithm on a weighted undirected
+ *                  graph, in parallel on all cores, and checks the cost of the
+ *                  tree against Kruskal's algorithm, as described in
+ *                  "Algorithms", by Jeff Erickson.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include <cstdlib>
+#include <chrono>
+#include "../../common/mst.h"
+#include "../../common/boruvka.h"
+#include "../../common/snapshot.h"
+using namespace std;
+
+/*** print_edges() prints the vector of edges as node1 --weight-- node2. ***/
+void print_edges(vector <pair <float, pair <int, int>>>& edges) {
+	vector <pair <float, pair <int, int>>>::iterator it;
+	for (it = edges.begin(); it != edges.end(); ++it) {
+		cout << (it->second).first << " --" << it->first << "-- " << (it->second).second << endl;
+	}
+	cout << endl;
+}
+
+/*** add_node() to vector of integer nodes. ***/
+void add_node(vector <int>& nodes, int u) {
+	nodes.push_back(u);
+}
+
+/*** add_edge() to vector of edges, weight included. ***/
+void add_edge(vector <pair <float, pair <int, int>>>& edges, int u, int v, float w) {
+	edges.push_back(make_pair(w, make_pair(u, v)));
+}
+
+/*** node_id() returns the integer node whose name is that of vertex u of a loaded graph. ***/
+int node_id(csr_graph& graph, int u) {
+	int64_t id;
+	if (!parse_int(graph.names[u], id)) throw runtime_error("node " + string(graph.names[u]) + " is not an integer");
+	return (int)id;
+}
+
+/*** load_graph() reads the nodes and undirected edges of an edge list or a snapshot whose nodes are integers. ***/
+void load_graph(const char* path, vector <int>& nodes, vector <pair <float, pair <int, int>>>& edges) {
+	csr_graph graph = open_graph(path, false);
+	for (int u = 0; u < graph.num_vertices(); u++) { add_node(nodes, node_id(graph, u)); }
+	for (int u = 0; u < graph.num_vertices(); u++) {
+		for (int64_t e = graph.begin(u); e < graph.end(u); e++) {
+			if (u < graph.targets[e]) add_edge(edges, nodes[u], nodes[graph.targets[e]], graph.weights[e]);
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+
+// create vector of nodes and vector of edges, from a file if one is given
+	vector <int> nodes;
+	vector <pair <float, pair <int, int>>> edges;
+	if (argc > 1) {
+		try { load_graph(argv[1], nodes, edges); }
+		catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
+	}
+	else {
+// add some nodes and edges
+		add_node(nodes, 1);
+		add_node(nodes, 2);
+		add_node(nodes, 3);
+		add_node(nodes, 4);
+		add_node(nodes, 5);
+		add_node(nodes, 6);
+		add_node(nodes, 7);
+		add_edge(edges, 1, 2, 26);
+		add_edge(edges, 1, 3, 4);
+		add_edge(edges, 1, 4, 14);
+		add_edge(edges, 3, 4, 12);
+		add_edge(edges, 2, 4, 30);
+		add_edge(edges, 3, 6, 18);
+		add_edge(edges, 2, 5, 16);
+		add_edge(edges, 4, 6, 2);
+		add_edge(edges, 4, 5, 3);
+		add_edge(edges, 5, 6, 10);
+		add_edge(edges, 6, 7, 8);
+		add_edge(edges, 5, 7, 5);
+	}
+	unsigned threads = (argc > 2) ? atoi(argv[2]) : 0;
+
+// the algorithms work on the index of every node in the vector of nodes
+	unordered_map <int, int> index;
+	for (int n = 0; n < nodes.size(); n++) { index[nodes[n]] = n; }
+	vector <pair <float, pair <int, int>>> indexed(edges.size());
+	for (int e = 0; e < edges.size(); e++) {
+		indexed[e] = make_pair(edges[e].first, make_pair(index[edges[e].second.first], index[edges[e].second.second]));
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	vector <pair <float, pair <int, int>>> F = boruvka_mst(nodes.size(), indexed, threads);
+	chrono::steady_clock::time_point middle = chrono::steady_clock::now();
+	vector <pair <float, pair <int, int>>> K = kruskal_mst(nodes.size(), indexed);
+	chrono::steady_clock::time_point stop = chrono::steady_clock::now();
+
+	for (int e = 0; e < F.size(); e++) { F[e].second = make_pair(nodes[F[e].second.first], nodes[F[e].second.second]); }
+	if (F.size() <= 100) {
+		cout << "selected edges after running Boruvka algorithm:" << endl;
+		print_edges(F);
+	}
+
+	float cost = tree_cost(F);
+	float check = tree_cost(K);
+	cout << "Final tree cost: " << cost << endl;
+	cout << "Kruskal tree cost: " << check << (cost == check ? " (same)" : " (DIFFERENT)") << endl;
+	cout << "Boruvka: " << chrono::duration <double>(middle - start).count() << " s, Kruskal: "
+		<< chrono::duration <double>(stop - middle).count() << " s" << endl << endl;
+
+	return cost == check ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+/**********************************************************************************
+ * FILE:            hierarchy.cpp
+ * DESCRIPTION:     This program builds a Contraction Hierarchy of a graph, or
+ *                  loads the one saved by an earlier run, and times random
+ *                  queries on it against Dijkstra's algorithm. With a source
+ *                  and a target, it prints the path between them instead.
+ *                  distance adds the weights, safety multiplies them as in
+ *                  exercise 25 and risk combines them as in exercise 26.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "../../common/csr_graph.h"
+#include "../../common/dijkstra.h"
+#include "../../common/contraction.h"
+#include "../../common/snapshot.h"
+using namespace std;
+
+/*** open_hierarchy() loads the hierarchy saved at path, or builds and saves it. ***/
+template <typename Semiring>
+contraction_hierarchy open_hierarchy(const csr_graph& graph, const string& path, const string& semantics) {
+	FILE* f = fopen(path.c_str(), "rb");
+	if (f != NULL) {
+		fclose(f);
+		cout << "Loading " << path << endl;
+		return contraction_hierarchy::load(path, graph, semantics);
+	}
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	contraction_hierarchy ch = contraction_hierarchy::build <Semiring>(graph, semantics);
+	double seconds = chrono::duration <double>(chrono::steady_clock::now() - start).count();
+	cout << "Contracted " << graph.num_vertices() << " nodes in " << seconds << " s, " << ch.up.size() + ch.down.size()
+		<< " arcs in the hierarchy for " << graph.num_arcs() << " in the graph" << endl;
+	ch.save(path);
+	return ch;
+}
+
+template <typename Semiring>
+int run(const csr_graph& graph, const string& path, const string& semantics, const vector <string>& args, int queries) {
+	contraction_hierarchy ch;
+	try { ch = open_hierarchy <Semiring>(graph, path, semantics); }
+	catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
+	ch_query Q(ch);
+	sssp_workspace <Semiring> W;
+
+// a single query: print its path
+	if (args.size() >= 5) {
+		int source = graph.find_vertex(args[3]), target = graph.find_vertex(args[4]);
+		if (source == -1 || target == -1) { cout << "Invalid source or target." << endl; return 1; }
+		if (Q.cost(source, target) == numeric_limits <double>::infinity()) { cout << "No path." << endl; return 0; }
+		vector <int> path = Q.path();
+		cout << "Path:";
+		for (int n = 0; n < path.size(); n++) { cout << " " << graph.names[path[n]]; }
+		W.run(graph, source, target);
+		double value = path_value <Semiring>(graph, path);
+		cout << endl << "\tValue: " << value << " (Dijkstra: " << W.value(target) << ")" << endl;
+		cout << "Settled vertices: " << Q.settled_count() << " (Dijkstra: " << W.settled().size() << ")" << endl;
+		return 0;
+	}
+
+// random queries: time them, and check the value of every path against Dijkstra
+	mt19937 random(12345);
+	uniform_int_distribution <int> pick(0, graph.num_vertices() - 1);
+	vector <pair <int, int>> pairs(queries);
+	for (int q = 0; q < queries; q++) { pairs[q] = make_pair(pick(random), pick(random)); }
+
+	double sink = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int q = 0; q < queries; q++) { sink += Q.cost(pairs[q].first, pairs[q].second); }
+	chrono::steady_clock::time_point middle = chrono::steady_clock::now();
+	for (int q = 0; q < queries; q++) { W.run(graph, pairs[q].first, pairs[q].second); }
+	chrono::steady_clock::time_point stop = chrono::steady_clock::now();
+
+	int same = 0, close = 0, wrong = 0;
+	for (int q = 0; q < queries; q++) {
+		int source = pairs[q].first, target = pairs[q].second;
+		Q.cost(source, target);
+		W.run(graph, source, target);
+		double value = path_value <Semiring>(graph, Q.path()), check = W.value(target);
+		if (value == check) same++;
+		else if (fabs(Semiring::cost(value) - Semiring::cost(check)) <= 1e-9 * (1 + fabs(Semiring::cost(check)))) close++;
+		else wrong++;
+	}
+	double ch_us = chrono::duration <double, micro>(middle - start).count() / queries;
+	double dijkstra_us = chrono::duration <double, micro>(stop - middle).count() / queries;
+	cout << queries << " queries: " << ch_us << " us per query with the hierarchy, " << dijkstra_us << " us with Dijkstra" << endl;
+	cout << "Paths of the same value as Dijkstra: " << same << ", equal up to rounding: " << close << ", different: " << wrong << endl;
+	return wrong == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+
+// arguments: graph hierarchy [distance|safety|risk [source target]] [--directed] [--queries=N]
+	vector <string> args;
+	bool directed = false;
+	int queries = 1000;
+	for (int n = 1; n < argc; n++) {
+		string arg = argv[n];
+		if (arg == "--directed") directed = true;
+		else if (arg.compare(0, 10, "--queries=") == 0) queries = atoi(arg.c_str() + 10);
+		else args.push_back(arg);
+	}
+	if (args.size() < 2) {
+		cout << "Usage: " << argv[0] << " graph hierarchy [distance|safety|risk [source target]] [--directed] [--queries=N]" << endl;
+		return 1;
+	}
+	string semantics = (args.size() > 2) ? args[2] : "distance";
+
+	csr_graph graph;
+	try { graph = open_graph(args[0], directed); }
+	catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
+	if (graph.num_vertices() == 0) { cout << "Error: the graph is empty." << endl; return 1; }
+
+	if (semantics == "distance") return run <min_sum>(graph, args[1], semantics, args, queries);
+	if (semantics == "safety") return run <max_product>(graph, args[1], semantics, args, queries);
+	if (semantics == "risk") return run <noisy_or>(graph, args[1], semantics, args, queries);
+	cout << "Unknown semantics " << semantics << "." << endl;
+	return 1;
+}
@@ -12,7 +12,14 @@
 #include <iterator>
 #include <utility> 
 #include <algorithm>
-#include <list>
+#include <unordered_map>
+#include <fstream>
+#include "../../common/disjoint_set.h"
+#include "../../common/filter_kruskal.h"
+#include "../../common/dynamic_mst.h"
+#include "../../common/external_kruskal.h"
+#include "../../common/snapshot.h"
+#include "../../common/trace.h"
 using namespace std;
 
 /*** print_nodes() prints the vector of integer nodes. ***/
@@ -33,17 +40,16 @@ void print_edges(vector <pair <float, pair <int, int>>>& edges) {
 	cout << endl;
 }
 
-/*** print_sets() prints the content of each set as the list of nodes. ***/
-void print_sets(vector <list <int>>& sets) {
-	vector <list <int>>::iterator j;
-	list <int>::iterator k;
-	int n;
-	for (j = sets.begin(); j != sets.end(); ++j) {
-		n = distance(sets.begin(), j);
+/*** print_sets() prints the content of each set as the list of nodes. Sets are named
+after the index of their representative node, looked up with root() so that tracing the
+sets does not add to the finds counter. ***/
+void print_sets(vector <int>& nodes, disjoint_set& sets) {
+	vector <vector <int>> members(nodes.size());
+	for (int n = 0; n < nodes.size(); n++) { members[sets.root(n)].push_back(nodes[n]); }
+	for (int n = 0; n < members.size(); n++) {
+		if (members[n].empty()) continue;
 		cout << "nodes in set " << n << ": ";
-		for (k = sets[n].begin(); k != sets[n].end(); ++k) {
-			cout << *k << " ";
-		}
+		for (int k = 0; k < members[n].size(); k++) { cout << members[n][k] << " "; }
 		cout << endl;
 	}
 	cout << endl;
@@ -59,116 +65,215 @@ void add_edge(vector <pair <float, pair <int, int>>>& edges, int u, int v, float
 	edges.push_back(make_pair(w, make_pair(u, v)));
 }
 
-/*** FIND(u) function: return the index of the sets vector where node u is included. ***/
-int find(vector <list <int>>& sets, int u) {
-	vector <list <int>>::iterator i;
-	list <int>::iterator j;
-	int n;
-	int index = -1;
-	for (i = sets.begin(); i != sets.end(); ++i) {
-		n = distance(sets.begin(), i);
-		for (j = sets[n].begin(); j != sets[n].end(); ++j) {
-			if (*j == u) { index = n; break; }
+/*** node_id() returns the integer node whose name is that of vertex u of a loaded graph. ***/
+int node_id(csr_graph& graph, int u) {
+	int64_t id;
+	if (!parse_int(graph.names[u], id)) throw runtime_error("node " + string(graph.names[u]) + " is not an integer");
+	return (int)id;
+}
+
+/*** load_graph() reads the nodes and undirected edges of an edge list or a snapshot whose nodes are integers. ***/
+void load_graph(const char* path, vector <int>& nodes, vector <pair <float, pair <int, int>>>& edges) {
+	csr_graph graph = open_graph(path, false);
+	for (int u = 0; u < graph.num_vertices(); u++) { add_node(nodes, node_id(graph, u)); }
+	for (int u = 0; u < graph.num_vertices(); u++) {
+		for (int64_t e = graph.begin(u); e < graph.end(u); e++) {
+			if (u < graph.targets[e]) add_edge(edges, nodes[u], nodes[graph.targets[e]], graph.weights[e]);
 		}
 	}
-	if (index == -1) {
-		cout << "Node " << u << " not found in any of the sets. Returning index -1." << endl;
-	}
-	return index;
 }
 
-/*** UNION(u, v) function: it adds the set containing the v node to that of the u node.
-It deletes the set containing the v node. ***/
-void unite(vector <list <int>>& sets, int u, int v) {
-	int n = find(sets, u);
-	int m = find(sets, v);
-	if (n == m) {
-		cout << "Nodes " << u << " and " << v << "are already in the same set." << endl;
-		return;
-	}
-	while (!sets[m].empty()) {
-		sets[n].push_back(sets[m].front());
-		sets[m].pop_front();
+/*** dynamic_kruskal() inserts the edges one by one, in input order, into a forest that is kept
+minimal as it goes, then applies the changes of the updates file, one "u v w" per line: a new
+edge, or a new weight for an edge that exists. The final forest is checked against Kruskal's
+algorithm over the edges as they end up. ***/
+int dynamic_kruskal(vector <int>& nodes, vector <pair <float, pair <int, int>>>& edges, const char* updates) {
+	int V = nodes.size();
+	unordered_map <int, int> index;
+	for (int n = 0; n < V; n++) { index[nodes[n]] = n; }
+	dynamic_mst D(V);
+	unordered_map <long long, int> number;		// edge between indices u < v -> number in D
+	auto key = [&](int u, int v) { return (long long)min(u, v) * V + max(u, v); };
+	auto change = [&](int u, int v, float w) {
+		int a = index[u], b = index[v];
+		unordered_map <long long, int>::iterator it = number.find(key(a, b));
+		if (it == number.end()) {
+			number[key(a, b)] = D.insert_edge(a, b, w);
+			TRACE(cout << "new edge: " << u << " --" << w << "-- " << v);
+		}
+		else {
+			D.set_weight(it->second, w);
+			TRACE(cout << "new weight: " << u << " --" << w << "-- " << v);
+		}
+		TRACE(cout << "\tforest cost: " << D.cost());
+		TRACE(if (D.replaced() != -1) {
+			mst_edge r = D.edge(D.replaced());
+			cout << "\treplaces " << nodes[r.second.first] << " --" << r.first << "-- " << nodes[r.second.second];
+		});
+		TRACE(cout << endl);
+	};
+
+	TRACE(cout << "START DYNAMIC FOREST" << endl << endl);
+	{
+		TRACE_PHASE("dynamic");
+		for (int e = 0; e < edges.size(); e++) { change(edges[e].second.first, edges[e].second.second, edges[e].first); }
+		if (updates != NULL) {
+			ifstream file(updates);
+			if (!file) { cout << "Error: cannot open " << updates << "." << endl; return 1; }
+			string line;
+			while (getline(file, line)) {
+				field words[3];
+				int k = split_words(line, words, 3);
+				if (k == 0 || words[0][0] == '#') continue;
+				int64_t u, v;
+				double w;
+				if (k != 3 || !parse_int(words[0], u) || !parse_int(words[1], v) || !parse_double(words[2], w) || !index.count(u) || !index.count(v)) {
+					cout << "Error: bad update: " << line << "." << endl;
+					return 1;
+				}
+				change(u, v, w);
+			}
+		}
 	}
-}
 
-/*** tree_cost() computes the cost of the final spanning tree. ***/
-float tree_cost(vector <pair <float, pair <int, int>>>& edges) {
-	float cost = 0.f;
-	vector <pair <float, pair <int, int>>>::iterator it;
-	for (it = edges.begin(); it != edges.end(); ++it) { cost += it->first; }
-	return cost;
+	vector <pair <float, pair <int, int>>> F = D.forest();
+	for (int e = 0; e < F.size(); e++) { F[e].second = make_pair(nodes[F[e].second.first], nodes[F[e].second.second]); }
+	cout << endl << "selected edges after inserting every edge and update:" << endl;
+	print_edges(F);
+	cout << "Final tree cost: " << tree_cost(F) << endl << endl;
+
+// check against Kruskal's algorithm over the final weights
+	vector <pair <float, pair <int, int>>> current(D.num_edges());
+	for (int e = 0; e < D.num_edges(); e++) { current[e] = D.edge(e); }
+	vector <pair <float, pair <int, int>>> K = kruskal_mst(V, current);
+	bool same = tree_cost(K) == tree_cost(F) && K.size() == F.size();
+	cout << (same ? "Same tree cost as Kruskal's algorithm." : "Error: the tree cost DIFFERS from Kruskal's algorithm.") << endl;
+	return same ? 0 : 1;
 }
 
 
 int main(int argc, char** argv) {
 
-// create vector of nodes, add some and print
+// arguments: [sort|filter|dynamic|external] [graph] [--updates=path] [--buffer=MB]
+	string mode = "sort";
+	const char* path = NULL;
+	const char* updates = NULL;
+	size_t buffer_mb = 256;
+	for (int a = 1; a < argc; a++) {
+		string arg = argv[a];
+		if (arg == "sort" || arg == "filter" || arg == "dynamic" || arg == "external") mode = arg;
+		else if (arg.compare(0, 10, "--updates=") == 0) updates = argv[a] + 10;
+		else if (arg.compare(0, 9, "--buffer=") == 0) buffer_mb = max(1, atoi(argv[a] + 9));
+		else path = argv[a];
+	}
+
+// the external mode streams the edge list from disk instead of loading it
+	if (mode == "external") {
+		if (path == NULL) { cout << "Error: the external mode needs an edge list." << endl; return 1; }
+		external_result R;
+		try { R = external_kruskal(path, buffer_mb << 20); }
+		catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
+		vector <pair <float, pair <int, int>>> F = R.forest;
+		for (int e = 0; e < F.size(); e++) { F[e].second = make_pair((int)R.names[F[e].second.first], (int)R.names[F[e].second.second]); }
+		cerr << R.edges << " edges sorted in " << R.runs << " runs" << endl;
+		cout << endl << "selected edges after running external Kruskal algorithm:" << endl;
+		print_edges(F);
+		cout << "Final tree cost: " << tree_cost(F) << endl << endl;
+		return 0;
+	}
+
+// create vector of nodes and vector of edges, from a file if one is given
 	vector <int> nodes;
-	add_node(nodes, 1);
-	add_node(nodes, 2);
-	add_node(nodes, 3);
-	add_node(nodes, 4);
-	add_node(nodes, 5);
-	add_node(nodes, 6);
-	add_node(nodes, 7);
-	cout << "these are the graph's nodes:" << endl;
-	print_nodes(nodes);
-
-// create vector of edges, add some and print
 	vector <pair <float, pair <int, int>>> edges;
-	add_edge(edges, 1, 2, 26);
-	add_edge(edges, 1, 3, 4);
-	add_edge(edges, 1, 4, 14);
-	add_edge(edges, 3, 4, 12);
-	add_edge(edges, 2, 4, 30);
-	add_edge(edges, 3, 6, 18);
-	add_edge(edges, 2, 5, 16);
-	add_edge(edges, 4, 6, 2);
-	add_edge(edges, 4, 5, 3);
-	add_edge(edges, 5, 6, 10);
-	add_edge(edges, 6, 7, 8);
-	add_edge(edges, 5, 7, 5);
-	cout << "edges as input:" << endl;
-	print_edges(edges);
+	if (path != NULL) {
+		TRACE_PHASE("load");
+		trace_steps() = false;
+		try { load_graph(path, nodes, edges); }
+		catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
+	}
+	else {
+// add some nodes and edges
+		add_node(nodes, 1);
+		add_node(nodes, 2);
+		add_node(nodes, 3);
+		add_node(nodes, 4);
+		add_node(nodes, 5);
+		add_node(nodes, 6);
+		add_node(nodes, 7);
+		add_edge(edges, 1, 2, 26);
+		add_edge(edges, 1, 3, 4);
+		add_edge(edges, 1, 4, 14);
+		add_edge(edges, 3, 4, 12);
+		add_edge(edges, 2, 4, 30);
+		add_edge(edges, 3, 6, 18);
+		add_edge(edges, 2, 5, 16);
+		add_edge(edges, 4, 6, 2);
+		add_edge(edges, 4, 5, 3);
+		add_edge(edges, 5, 6, 10);
+		add_edge(edges, 6, 7, 8);
+		add_edge(edges, 5, 7, 5);
+	}
+	TRACE(cout << "these are the graph's nodes:" << endl; print_nodes(nodes));
+	TRACE(cout << "edges as input:" << endl; print_edges(edges));
+
+// the dynamic forest takes the edges in input order, then a stream of updates
+	if (mode == "dynamic") return dynamic_kruskal(nodes, edges, updates);
+
+// Filter-Kruskal only sorts the edges that may still join two components
+	if (mode == "filter") {
+		unordered_map <int, int> index;
+		for (int n = 0; n < nodes.size(); n++) { index[nodes[n]] = n; }
+		vector <pair <float, pair <int, int>>> indexed(edges.size());
+		for (int e = 0; e < edges.size(); e++) {
+			indexed[e] = make_pair(edges[e].first, make_pair(index[edges[e].second.first], index[edges[e].second.second]));
+		}
+		vector <pair <float, pair <int, int>>> F;
+		{
+			TRACE_PHASE("filter_kruskal");
+			F = filter_kruskal_mst(nodes.size(), indexed);
+		}
+		for (int e = 0; e < F.size(); e++) { F[e].second = make_pair(nodes[F[e].second.first], nodes[F[e].second.second]); }
+		cout << endl << "selected edges after running Filter-Kruskal algorithm:" << endl;
+		print_edges(F);
+		cout << "Final tree cost: " << tree_cost(F) << endl << endl;
+		return 0;
+	}
 
 // sort edges by ascending order of the first element in pair, i.e. the weight, and print
-	cout << "sorted edges:" << endl;
-	sort(edges.begin(), edges.end());
-	print_edges(edges);
+	{
+		TRACE_PHASE("sort");
+		sort(edges.begin(), edges.end());
+	}
+	TRACE(cout << "sorted edges:" << endl; print_edges(edges));
 
 // create vector of edges F, where we will dump the selected edges
 	vector <pair <float, pair <int, int>>> F;
 
-// for each node v, MAKE_SET(v): each set is a component of vector sets and print the content of each set
+// for each node v, MAKE_SET(v): the union-find works on the index of v in the vector of nodes
 	int V = nodes.size();
-	int n;
-	vector <list <int>> sets(V);
-	vector <int>::iterator i;
-	for (i = nodes.begin(); i != nodes.end(); ++i) {
-		n = distance(nodes.begin(), i);
-		sets[n].push_back(*i);
-	}
-	cout << "individual sets created: " << endl;
-	print_sets(sets);
+	disjoint_set sets(V);
+	unordered_map <int, int> index;
+	for (int n = 0; n < V; n++) { index[nodes[n]] = n; }
+	TRACE(cout << "individual sets created: " << endl; print_sets(nodes, sets));
 
-// iterate over all (sorted) edges, and copy into F only those that do not close any cycles
+// iterate over the (sorted) edges, and copy into F only those that do not close any cycles,
+// until F spans the graph with V - 1 edges
 	int u, v;
 	vector <pair <float, pair <int, int>>>::iterator it;
-	cout << "START KRUSKAL ALGORITHM" << endl << endl;
-	for (it = edges.begin(); it != edges.end(); ++it) {
-		u = (it->second).first;
-		v = (it->second).second;
-		cout << "we are scanning edge: " << u << " --" << (it->first) << "-- " << v << endl;
-		if (find(sets, u) != find(sets, v)) {
-			unite(sets, u, v);
-			F.push_back(*it);
-			cout << "the edge is safe to be selected" << endl;
-			cout << "new sets:" << endl;
-			print_sets(sets);
-		}
-		else {
-			cout << "the edge is not safe" << endl << endl;
+	TRACE(cout << "START KRUSKAL ALGORITHM" << endl << endl);
+	{
+		TRACE_PHASE("kruskal");
+		for (it = edges.begin(); it != edges.end() && (int)F.size() < V - 1; ++it) {
+			u = (it->second).first;
+			v = (it->second).second;
+			TRACE(cout << "we are scanning edge: " << u << " --" << (it->first) << "-- " << v << endl);
+			if (sets.unite(index[u], index[v])) {
+				F.push_back(*it);
+				TRACE(cout << "the edge is safe to be selected" << endl << "new sets:" << endl; print_sets(nodes, sets));
+			}
+			else {
+				TRACE(cout << "the edge is not safe" << endl << endl);
+			}
 		}
 	}
 
@@ -10,19 +10,20 @@
 #include <iostream>
 #include <cstdlib>
 #include <cmath>
+#include <string>
 #include <vector>
 #include <iterator>
 #include <utility> 
-#include <algorithm>
-#include <list>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include "../../common/csr_graph.h"
+#include "../../common/indexed_heap.h"
+#include "../../common/integer_queues.h"
+#include "../../common/snapshot.h"
+#include "../../common/trace.h"
 using namespace std;
 
-struct node_prop {
-	int id;
-	pair <float, pair <int, int>>* node_edge;
-	float prior;
-};
-
 /*** print_nodes() prints the vector of integer nodes. ***/
 void print_nodes(vector <int>& nodes) {
 	vector <int>::iterator it;
@@ -41,18 +42,6 @@ void print_edges(vector <pair <float, pair <int, int>>>& edges) {
 	cout << endl;
 }
 
-/*** print_properties() prints the current values of the priority queue ***/
-void print_properties(vector <node_prop> P) {
-	vector <node_prop>::iterator it;
-	for (it = P.begin(); it != P.end(); ++it) {
-		cout << "node " << it->id << "; ";
-		if ((it->node_edge) == nullptr) { cout << "edge NULL; "; }
-		else { cout << "edge " << ((it->node_edge)->second).first << " --" << (it->node_edge)->first << "-- " << ((it->node_edge)->second).second << "; "; }
-		cout << "priority " << it->prior << endl;
-	}
-	cout << endl;
-}
-
 /*** add_node() to vector of integer nodes. ***/
 void add_node(vector <int>& nodes, int u) {
 	nodes.push_back(u);
@@ -63,49 +52,144 @@ void add_edge(vector <pair <float, pair <int, int>>>& edges, int u, int v, float
 	edges.push_back(make_pair(w, make_pair(u, v)));
 }
 
-/*** find_edge() returns a pointer to the edge between nodes v and s. If there is no such node, it returns a null pointer. ***/
-pair <float, pair <int, int>>* find_edge(vector <pair <float, pair <int, int>>>& edges, int v, int s) {
+/*** node_id() returns the integer node whose name is that of vertex u of a loaded graph. ***/
+int node_id(csr_graph& graph, int u) {
+	int64_t id;
+	if (!parse_int(graph.names[u], id)) throw runtime_error("node " + string(graph.names[u]) + " is not an integer");
+	return (int)id;
+}
+
+/*** build_adjacency() indexes the edges by node, so the neighbors of a node and the weights of
+the edges to them can be read without scanning the whole edge vector. Vertex n of the graph is
+nodes[n]. ***/
+csr_graph build_adjacency(vector <int>& nodes, vector <pair <float, pair <int, int>>>& edges, unordered_map <int, int>& index) {
+	graph_builder G;
+	for (int n = 0; n < nodes.size(); n++) { index[nodes[n]] = G.add_vertex(to_string(nodes[n])); }
 	vector <pair <float, pair <int, int>>>::iterator it;
 	for (it = edges.begin(); it != edges.end(); ++it) {
-		if ((it->second).first == v && (it->second).second == s) { return &(*it); }
-		if ((it->second).first == s && (it->second).second == v) { return &(*it); }
+		G.add_edge(index[(it->second).first], index[(it->second).second], it->first);
 	}
-	return nullptr;
+	return G.build();
 }
 
-/*** sorting() is a custom function to help sort variables of type node_prop by descending priority. ***/
-bool sorting(node_prop a, node_prop b) { return (a.prior > b.prior); }
+/*** prim_indexed() keeps every node outside the tree in an indexed heap, keyed by the weight of
+its lightest edge to the tree, and lowers that key in place when a lighter edge shows up. ***/
+void prim_indexed(csr_graph& graph, vector <int>& nodes, int s, vector <int>& T_nodes, vector <pair <float, pair <int, int>>>& T_edges) {
+	int V = graph.num_vertices();
+	indexed_heap <float> P(V);
+	vector <int> parent(V, -1);
+	for (int v = 0; v < V; v++) { if (v != s) P.push(v, INFINITY); }
 
-/*** find_neighbors() returns a vector of the neighbors of node v. ***/
-vector <int> find_neighbors(vector <pair <float, pair <int, int>>>& edges, int v) {
-	vector <int> neighbors;
-	vector <pair <float, pair <int, int>>>::iterator it;
-	for (it = edges.begin(); it != edges.end(); ++it) {
-		if ((it->second).first == v) neighbors.push_back((it->second).second);
-		if ((it->second).second == v) neighbors.push_back((it->second).first);
+	int currNode = s;
+	T_nodes.push_back(nodes[s]);
+	while (true) {
+		TRACE_ADD(relaxations, graph.end(currNode) - graph.begin(currNode));
+		for (int64_t e = graph.begin(currNode); e < graph.end(currNode); e++) {
+			int v = graph.targets[e];
+			float w = graph.weights[e];
+			if (!P.contains(v)) {
+				TRACE(cout << "neighbor " << nodes[v] << " is no longer in the priority queue." << endl);
+				continue;
+			}
+			float prior_neighbor = P.key(v);
+			if (prior_neighbor > w) {
+				P.decrease_key(v, w);
+				parent[v] = currNode;
+				TRACE(cout << "neighbor " << nodes[v] << " has updated its priority from " << prior_neighbor << " to " << w << "." << endl);
+			}
+			else TRACE(cout << "neighbor " << nodes[v] << " has not updated its priority." << endl);
+		}
+		TRACE(cout << endl);
+		if (P.empty()) break;
+		float prior = P.top_key();
+		currNode = P.pop();
+		TRACE(cout << "selected node: " << nodes[currNode] << endl);
+		T_nodes.push_back(nodes[currNode]);
+		if (parent[currNode] == -1) { T_edges.push_back(pair <float, pair <int, int>>()); }
+		else T_edges.push_back(make_pair(prior, make_pair(nodes[parent[currNode]], nodes[currNode])));
 	}
-	return neighbors;
 }
 
-/*** find_priority() returns the priority of node v. ***/
-float find_priority(vector <node_prop>& P, int v) {
-	vector <node_prop>::iterator it;
-	for (it = P.begin(); it != P.end(); ++it) {
-		if (it->id == v) { return it->prior; }
+/*** prim_lazy() pushes every edge leaving the tree into a binary heap and discards, when they
+reach the top, the ones whose endpoint has already joined the tree. ***/
+void prim_lazy(csr_graph& graph, vector <int>& nodes, int s, vector <int>& T_nodes, vector <pair <float, pair <int, int>>>& T_edges) {
+	int V = graph.num_vertices();
+	typedef pair <float, pair <int, int>> candidate;	// weight, (node outside, node in the tree)
+	priority_queue <candidate, vector <candidate>, greater <candidate>> P;
+	vector <bool> in_tree(V, false);
+
+	int currNode = s;
+	in_tree[s] = true;
+	T_nodes.push_back(nodes[s]);
+	while (true) {
+		TRACE_ADD(relaxations, graph.end(currNode) - graph.begin(currNode));
+		for (int64_t e = graph.begin(currNode); e < graph.end(currNode); e++) {
+			int v = graph.targets[e];
+			if (in_tree[v]) continue;
+			P.push(make_pair((float)graph.weights[e], make_pair(v, currNode)));
+			TRACE_COUNT(heap_pushes);
+		}
+		while (!P.empty() && in_tree[P.top().second.first]) {
+			P.pop();
+			TRACE_COUNT(heap_pops);
+		}
+		if (P.empty()) break;
+		candidate best = P.top();
+		P.pop();
+		TRACE_COUNT(heap_pops);
+		currNode = best.second.first;
+		in_tree[currNode] = true;
+		TRACE(cout << "selected node: " << nodes[currNode] << endl);
+		T_nodes.push_back(nodes[currNode]);
+		T_edges.push_back(make_pair(best.first, make_pair(nodes[best.second.second], nodes[currNode])));
 	}
-	if (it == P.end()) {
-		cout << "Node " << v << " is not in the priority vector. find_priority() will return inf." << endl;
-		return INFINITY;
+	// nodes that no edge could reach, as the INFINITY priorities of prim_indexed()
+	for (int v = 0; v < V; v++) {
+		if (in_tree[v]) continue;
+		T_nodes.push_back(nodes[v]);
+		T_edges.push_back(pair <float, pair <int, int>>());
 	}
 }
 
-/*** find_in_queue() returns an integer index such that P[n] corresponds to node v. If v is not in P, it returns -1. ***/
-int find_in_queue(vector <node_prop>& P, int v) {
-	vector <node_prop>::iterator it;
-	for (it = P.begin(); it != P.end(); ++it) {
-		if (it->id == v) { return distance(P.begin(), it); }
+/*** prim_bucket() is prim_indexed() with Dial's bucket queue, one bucket per integer weight, so
+that the lightest edge to the tree is found by walking the buckets instead of comparing keys.
+Nodes enter the queue when an edge first reaches them. ***/
+void prim_bucket(csr_graph& graph, vector <int>& nodes, int s, vector <int>& T_nodes, vector <pair <float, pair <int, int>>>& T_edges) {
+	int V = graph.num_vertices();
+	bucket_queue P(V);
+	vector <int> parent(V, -1);
+	vector <bool> in_tree(V, false);
+
+	int currNode = s;
+	in_tree[s] = true;
+	T_nodes.push_back(nodes[s]);
+	while (true) {
+		TRACE_ADD(relaxations, graph.end(currNode) - graph.begin(currNode));
+		for (int64_t e = graph.begin(currNode); e < graph.end(currNode); e++) {
+			int v = graph.targets[e];
+			bucket_queue::key_type w = (bucket_queue::key_type)graph.weights[e];
+			if (in_tree[v]) continue;
+			if (!P.contains(v) || P.key(v) > w) {
+				P.update(v, w);
+				parent[v] = currNode;
+				TRACE(cout << "neighbor " << nodes[v] << " has updated its priority to " << w << "." << endl);
+			}
+			else TRACE(cout << "neighbor " << nodes[v] << " has not updated its priority." << endl);
+		}
+		TRACE(cout << endl);
+		if (P.empty()) break;
+		currNode = P.pop();
+		in_tree[currNode] = true;
+		TRACE(cout << "selected node: " << nodes[currNode] << endl);
+		T_nodes.push_back(nodes[currNode]);
+		T_edges.push_back(make_pair((float)P.key(currNode), make_pair(nodes[parent[currNode]], nodes[currNode])));
+	}
+	// nodes that no edge could reach, as the INFINITY priorities of prim_indexed()
+	for (int v = 0; v < V; v++) {
+		if (in_tree[v]) continue;
+		T_nodes.push_back(nodes[v]);
+		T_edges.push_back(pair <float, pair <int, int>>());
 	}
-	if (it == P.end()) { return -1; }
 }
 
 /*** tree_cost() computes the cost of the final spanning tree. ***/
@@ -118,101 +202,72 @@ float tree_cost(vector <pair <float, pair <int, int>>>& edges) {
 
 int main(int argc, char** argv) {
 
-// create vector of nodes, add some and print
+	if (argc < 2) { cout << "Usage: " << argv[0] << " source [indexed|lazy|bucket] [edge list or snapshot]" << endl; return 1; }
+
 	vector <int> nodes;
-	add_node(nodes, 1);
-	add_node(nodes, 2);
-	add_node(nodes, 3);
-	add_node(nodes, 4);
-	add_node(nodes, 5);
-	add_node(nodes, 6);
-	add_node(nodes, 7);
-	cout << "these are the graph's nodes:" << endl;
-	print_nodes(nodes);
-
-// create vector of edges, add some and print
-	vector <pair <float, pair <int, int>>> edges;
-	add_edge(edges, 1, 2, 26);
-	add_edge(edges, 1, 3, 4);
-	add_edge(edges, 1, 4, 14);
-	add_edge(edges, 3, 4, 12);
-	add_edge(edges, 2, 4, 30);
-	add_edge(edges, 3, 6, 18);
-	add_edge(edges, 2, 5, 16);
-	add_edge(edges, 4, 6, 2);
-	add_edge(edges, 4, 5, 3);
-	add_edge(edges, 5, 6, 10);
-	add_edge(edges, 6, 7, 8);
-	add_edge(edges, 5, 7, 5);
-	cout << "edges as input:" << endl;
-	print_edges(edges);
+	unordered_map <int, int> index;
+	csr_graph graph;
+	if (argc > 3) {
+// read the graph from a file and use its adjacency as it is; nodes are named by integers
+		TRACE_PHASE("load");
+		trace_steps() = false;
+		try {
+			graph = open_graph(argv[3], false);
+			for (int u = 0; u < graph.num_vertices(); u++) {
+				add_node(nodes, node_id(graph, u));
+				index[nodes[u]] = u;
+			}
+		}
+		catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
+		cout << "graph with " << nodes.size() << " nodes and " << graph.num_arcs() / 2 << " edges" << endl << endl;
+	}
+	else {
+// create vector of nodes and vector of edges, add some and print
+		vector <pair <float, pair <int, int>>> edges;
+		add_node(nodes, 1);
+		add_node(nodes, 2);
+		add_node(nodes, 3);
+		add_node(nodes, 4);
+		add_node(nodes, 5);
+		add_node(nodes, 6);
+		add_node(nodes, 7);
+		add_edge(edges, 1, 2, 26);
+		add_edge(edges, 1, 3, 4);
+		add_edge(edges, 1, 4, 14);
+		add_edge(edges, 3, 4, 12);
+		add_edge(edges, 2, 4, 30);
+		add_edge(edges, 3, 6, 18);
+		add_edge(edges, 2, 5, 16);
+		add_edge(edges, 4, 6, 2);
+		add_edge(edges, 4, 5, 3);
+		add_edge(edges, 5, 6, 10);
+		add_edge(edges, 6, 7, 8);
+		add_edge(edges, 5, 7, 5);
+		TRACE(cout << "these are the graph's nodes:" << endl; print_nodes(nodes));
+		TRACE(cout << "edges as input:" << endl; print_edges(edges));
 
-// select source node
-	int s = atoi(argv[1]);
-	if (s > nodes.size()) { cout << "Invalid source." << endl; return 1; }
-// remove source from nodes vector (erase-remove idiom)
-	nodes.erase(remove(nodes.begin(), nodes.end(), s));
-	cout << "nodes after deleting the source:" << endl;
-	print_nodes(nodes);
-
-// Initialize priority queue
-	vector <node_prop> P;
-	vector <int>::iterator i;
-	pair <float, pair <int, int>>* the_edge;
-	float prior;
-	for (i = nodes.begin(); i != nodes.end(); ++i) {
-		the_edge = find_edge(edges, *i, s);
-		if (the_edge == nullptr) { prior = INFINITY; }
-		else { prior = the_edge->first; }
-		P.push_back({ *i, the_edge, prior });
+// index the edges by node
+		graph = build_adjacency(nodes, edges, index);
 	}
-	cout << "initial priority queue:" << endl;
-	print_properties(P);
 
-	sort(P.begin(), P.end(), sorting);
-	cout << "initial priority queue after sorting:" << endl;
-	print_properties(P);
+// select source node
+	int s = atoi(argv[1]);
+	if (index.find(s) == index.end()) { cout << "Invalid source." << endl; return 1; }
+	string mode = (argc > 2) ? argv[2] : "indexed";
+	if (mode != "indexed" && mode != "lazy" && mode != "bucket") { cout << "Unknown priority queue " << mode << "." << endl; return 1; }
+	double largest = 0;
+	if (mode == "bucket" && !integral_weights(graph, largest)) { cout << "Error: the bucket queue needs non-negative integer weights." << endl; return 1; }
+	if (mode == "bucket" && largest >= bucket_queue::max_spread) { cout << "Error: the weights are too large for the bucket queue." << endl; return 1; }
 
 // Prim Loop
 	vector <int> T_nodes;
-	T_nodes.push_back(s);
 	vector <pair <float, pair <int, int>>> T_edges;
-	node_prop currNode;
-	vector <int> neighbors;
-	int n_neighbor;
-	pair <float, pair <int, int>>* edge_to_curr;
-	float prior_neighbor, w;
-
-	cout << "START PRIM ALGORITHM" << endl << endl;
-	while (!P.empty()) {
-		currNode = P.back();
-		P.pop_back();
-		cout << "selected node: " << currNode.id << endl;
-		T_nodes.push_back(currNode.id);
-		if (currNode.node_edge == nullptr) { T_edges.push_back(pair <float, pair <int, int>>()); }
-		else T_edges.push_back(*currNode.node_edge);
-		neighbors = find_neighbors(edges, currNode.id);
-		cout << "current node's neighbors:" << endl;
-		print_nodes(neighbors);
-		for (i = neighbors.begin(); i != neighbors.end(); ++i) {
-			n_neighbor = find_in_queue(P, *i);
-			if (n_neighbor == -1) {
-				cout << "neighbor " << *i << " is no longer in the priority queue." << endl;
-				continue;
-			}
-			edge_to_curr = find_edge(edges, currNode.id, *i);
-			prior_neighbor = P[n_neighbor].prior;
-			w = edge_to_curr->first;
-			if (prior_neighbor > w) {
-				P[n_neighbor].node_edge = edge_to_curr;
-				P[n_neighbor].prior = w;
-				cout << "neighbor " << *i << " has updated its priority from " << prior_neighbor << " to " << w << "." << endl;
-			}
-			else cout << "neighbor " << *i << " has not updated its priority." << endl;
-		}
-		sort(P.begin(), P.end(), sorting);
-		cout << endl << "updated priority queue:" << endl;
-		print_properties(P);
+	TRACE(cout << "START PRIM ALGORITHM (" << mode << " priority queue)" << endl << endl);
+	{
+		TRACE_PHASE("prim");
+		if (mode == "lazy") prim_lazy(graph, nodes, index[s], T_nodes, T_edges);
+		else if (mode == "bucket") prim_bucket(graph, nodes, index[s], T_nodes, T_edges);
+		else prim_indexed(graph, nodes, index[s], T_nodes, T_edges);
 	}
 
 	cout << endl << "selected nodes after running Prim algorithm (all nodes):" << endl;
@@ -0,0 +1,337 @@
+/**********************************************************************************
+ * FILE:            query_server.cpp
+ * DESCRIPTION:     This program loads a graph once and answers a stream of
+ *                  shortest path queries, one per line:
+ *                      source target [safety|risk|distance|width]
+ *                  safety is the most reliable path of exercise 25, risk the
+ *                  least risky path of exercise 26, distance the shortest
+ *                  path and width the widest one. Every answer is one line,
+ *                  in the order of the queries:
+ *                      value node1 node2 ...   or   unreachable   or   error ...
+ *                  Queries are read from stdin, or from the clients of a local
+ *                  Unix socket, each one on its own thread, and answered in
+ *                  batches by a fixed team of threads, each one reusing its
+ *                  own search arrays. The batches of several clients take
+ *                  turns on the team. Answers
+ *                  and paths are built in an arena per thread, emptied after
+ *                  every batch, so answering allocates no memory once the
+ *                  first batches have been served.
+ *                  Distances on integer weights can be searched with a radix
+ *                  heap or Dial's bucket queue instead of the binary heap
+ *                  (--queue=radix|bucket, see integer_queues.h).
+ *                  With --cache=MB, the whole tree of every source searched is
+ *                  kept (tree_cache.h), so that later queries from the same
+ *                  source only walk back from their target; --spill=path keeps
+ *                  the trees that do not fit in a file, for this run and the
+ *                  next ones on the same graph.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "../../common/arena.h"
+#include "../../common/csr_graph.h"
+#include "../../common/dijkstra.h"
+#include "../../common/integer_queues.h"
+#include "../../common/tree_cache.h"
+#include "../../common/snapshot.h"
+#include "../../common/parallel.h"
+#ifdef _WIN32
+#include <io.h>
+#define read _read
+#define write _write
+#else
+#include <unistd.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+using namespace std;
+
+/*** line_reader splits the bytes of a file descriptor into lines. ***/
+class line_reader {
+public:
+	explicit line_reader(int fd) : fd(fd) {}
+
+	/*** read_batch() waits for at least one line, then takes every complete line that can be
+	read without waiting, up to max. It returns false at the end of the input. ***/
+	bool read_batch(vector <string>& lines, size_t max) {
+		lines.clear();
+		while (lines.size() < max) {
+			size_t eol = buffer.find('\n', begin);
+			if (eol != string::npos) {
+				size_t end = (eol > begin && buffer[eol - 1] == '\r') ? eol - 1 : eol;
+				lines.push_back(buffer.substr(begin, end - begin));
+				begin = eol + 1;
+				continue;
+			}
+			if (eof || (!lines.empty() && !ready())) break;
+			buffer.erase(0, begin);
+			begin = 0;
+			char chunk[1 << 16];
+			long got = read(fd, chunk, sizeof(chunk));
+			if (got <= 0) {
+				eof = true;
+				// a last line without a line break
+				if (buffer.size() > 0) lines.push_back(buffer);
+				buffer.clear();
+			}
+			else buffer.append(chunk, got);
+		}
+		return !lines.empty();
+	}
+
+private:
+	int fd;
+	string buffer;
+	size_t begin = 0;
+	bool eof = false;
+
+	/*** ready() tells whether read() would return at once. ***/
+	bool ready() const {
+#ifdef _WIN32
+		return false;
+#else
+		pollfd p = { fd, POLLIN, 0 };
+		return poll(&p, 1, 0) > 0;
+#endif
+	}
+};
+
+/*** write_all() writes the whole string to a file descriptor. ***/
+bool write_all(int fd, const string& s) {
+	size_t done = 0;
+	while (done < s.size()) {
+		long put = write(fd, s.data() + done, s.size() - done);
+		if (put <= 0) return false;
+		done += put;
+	}
+	return true;
+}
+
+/*** The search arrays of one thread, one set per path semantics, and the arena that holds its
+answers until they are written. ***/
+struct workspace {
+	sssp_workspace <max_product> safety;
+	sssp_workspace <noisy_or> risk;
+	sssp_workspace <min_sum> distance;
+	sssp_workspace <min_sum, radix_heap> distance_radix;
+	sssp_workspace <min_sum, bucket_queue> distance_bucket;
+	sssp_workspace <bottleneck> width;
+	arena memory;
+	string line;			// answer being built
+};
+
+class query_server {
+public:
+	query_server(const csr_graph& graph, unsigned threads, string semantics, string queue = "heap", tree_cache* cache = nullptr)
+		: graph(graph), team(threads), spaces(team.size()), semantics(semantics), queue(queue), cache(cache) {
+		for (int v = 0; v < graph.num_vertices(); v++) { index[graph.names[v]] = v; }
+	}
+
+	/*** serve() answers the queries read from in on out, and returns how many there were. It may
+	be called by several threads at once, whose batches then take turns. ***/
+	size_t serve(int in, int out) {
+		line_reader reader(in);
+		vector <string> lines;
+		vector <string_view> answers;
+		size_t total = 0;
+		while (reader.read_batch(lines, batch)) {
+			string text;
+			{
+				lock_guard <mutex> lock(busy);
+				answers.assign(lines.size(), string_view());
+				atomic <size_t> next(0);
+				team.run([&](unsigned t) {
+					for (size_t i = next.fetch_add(1); i < lines.size(); i = next.fetch_add(1)) { answers[i] = answer(lines[i], spaces[t]); }
+				});
+				for (size_t i = 0; i < lines.size(); i++) {
+					if (answers[i].empty()) continue;	// blank line or comment
+					text += answers[i];
+					text += '\n';
+					total++;
+				}
+				for (size_t t = 0; t < spaces.size(); t++) { spaces[t].memory.reset(); }
+			}
+			if (!write_all(out, text)) break;
+		}
+		return total;
+	}
+
+private:
+	static const size_t batch = 4096;		// most queries answered in one parallel step
+
+	const csr_graph& graph;
+	thread_team team;
+	vector <workspace> spaces;
+	mutex busy;					// held while the team answers a batch
+	string semantics;			// used by queries that do not name one
+	string queue;				// for distances: heap, radix or bucket
+	tree_cache* cache;			// or null
+	unordered_map <string_view, int> index;
+
+	int find(field name) const {
+		unordered_map <string_view, int>::const_iterator it = index.find(name);
+		return (it == index.end()) ? -1 : it->second;
+	}
+
+	/*** answer() returns the answer to one line, which stays in the arena of w until the
+	batch is written. Blank lines and comments have an empty answer. ***/
+	string_view answer(const string& line, workspace& w) const {
+		field words[4];
+		int k = split_words(line, words, 4);
+		if (k == 0 || words[0][0] == '#') return string_view();
+		if (k < 2 || k > 3) return "error expected: source target [safety|risk|distance|width]";
+		int source = find(words[0]), target = find(words[1]);
+		if (source == -1) return error(w, "error unknown node ", words[0]);
+		if (target == -1) return error(w, "error unknown node ", words[1]);
+		field kind = (k == 3) ? words[2] : field(semantics);
+		if (kind == "safety") return search(w, w.safety, 0, source, target);
+		if (kind == "risk") return search(w, w.risk, 1, source, target);
+		if (kind == "distance") {
+			if (queue == "radix") return search(w, w.distance_radix, 4, source, target);
+			if (queue == "bucket") return search(w, w.distance_bucket, 5, source, target);
+			return search(w, w.distance, 2, source, target);
+		}
+		if (kind == "width") return search(w, w.width, 3, source, target);
+		return error(w, "error unknown semantics ", kind);
+	}
+
+	/*** search() answers one query by the search of ws, or by the tree cached under its source and
+	tag, which tells the semantics and queue of the search apart. ***/
+	template <typename Semiring, typename Queue>
+	string_view search(workspace& w, sssp_workspace <Semiring, Queue>& ws, uint64_t tag, int source, int target) const {
+		array_view <int> path;
+		double best;
+		if (cache != nullptr) {
+			uint64_t key = (tag << 32) | (uint32_t)source;
+			shared_ptr <const compact_tree> T = cache->find(key);
+			if (!T) {
+				ws.run(graph, source);
+				T = cache->insert(key, compact(ws, source, graph.num_vertices()));
+			}
+			path = tree_path(*T, target, w.memory);
+			if (path.empty()) return "unreachable";
+			best = path_value <Semiring>(graph, path);
+		}
+		else {
+			if (!ws.run(graph, source, target)) return "unreachable";
+			best = ws.value(target);
+			path = ws.path(target, w.memory);
+		}
+		char value[32];
+		snprintf(value, sizeof(value), "%.17g", best);
+		w.line = value;
+		for (int n = 0; n < path.size(); n++) {
+			w.line += ' ';
+			w.line += graph.names[path[n]];
+		}
+		return keep(w, w.line);
+	}
+
+	string_view error(workspace& w, const char* message, field word) const {
+		w.line = message;
+		w.line += word;
+		return keep(w, w.line);
+	}
+
+	/*** keep() copies an answer into the arena of w. ***/
+	static string_view keep(workspace& w, const string& s) {
+		char* copy = w.memory.allocate_array <char>(s.size());
+		memcpy(copy, s.data(), s.size());
+		return string_view(copy, s.size());
+	}
+};
+
+/*** listen_on() serves the clients of a Unix socket at path, each one on its own thread, forever. ***/
+int listen_on(query_server& server, const string& path) {
+#ifdef _WIN32
+	cout << "Error: Unix sockets are not available on this system." << endl;
+	return 1;
+#else
+	signal(SIGPIPE, SIG_IGN);
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (fd < 0 || path.size() >= sizeof(address.sun_path)) { cout << "Error: cannot create socket " << path << "." << endl; return 1; }
+	strcpy(address.sun_path, path.c_str());
+	unlink(path.c_str());
+	if (bind(fd, (sockaddr*)&address, sizeof(address)) != 0 || listen(fd, 16) != 0) {
+		cout << "Error: cannot listen on " << path << "." << endl;
+		return 1;
+	}
+	cerr << "Listening on " << path << endl;
+	while (true) {
+		int client = accept(fd, NULL, NULL);
+		if (client < 0) continue;
+		thread([&server, client]() {
+			server.serve(client, client);
+			close(client);
+		}).detach();
+	}
+#endif
+}
+
+int main(int argc, char** argv) {
+
+// arguments: graph [--directed] [--threads=N] [--semantics=S] [--socket=path] [--queue=heap|radix|bucket] [--cache=MB] [--spill=path]
+	vector <string> args;
+	bool directed = false;
+	unsigned threads = 0;
+	string semantics = "distance", socket_path, queue = "heap", spill_path;
+	int cache_mb = 0;
+	for (int n = 1; n < argc; n++) {
+		string arg = argv[n];
+		if (arg == "--directed") directed = true;
+		else if (arg.compare(0, 10, "--threads=") == 0) threads = atoi(arg.c_str() + 10);
+		else if (arg.compare(0, 12, "--semantics=") == 0) semantics = arg.substr(12);
+		else if (arg.compare(0, 9, "--socket=") == 0) socket_path = arg.substr(9);
+		else if (arg.compare(0, 8, "--queue=") == 0) queue = arg.substr(8);
+		else if (arg.compare(0, 8, "--cache=") == 0) cache_mb = atoi(arg.c_str() + 8);
+		else if (arg.compare(0, 8, "--spill=") == 0) spill_path = arg.substr(8);
+		else args.push_back(arg);
+	}
+	if (args.size() != 1) {
+		cout << "Usage: " << argv[0] << " graph [--directed] [--threads=N] [--semantics=safety|risk|distance|width] [--socket=path] [--queue=heap|radix|bucket] [--cache=MB] [--spill=path]" << endl;
+		return 1;
+	}
+	if (queue != "heap" && queue != "radix" && queue != "bucket") { cout << "Error: unknown queue " << queue << "." << endl; return 1; }
+
+	csr_graph graph;
+	unique_ptr <tree_cache> cache;
+	try {
+		uint64_t id = 0;
+		bool snapshot = is_snapshot(args[0]);
+		graph = open_graph(args[0], directed, &id);
+		if (!snapshot && cache_mb > 0) id = graph_id(graph);
+		if (cache_mb > 0) cache.reset(new tree_cache(graph.num_vertices(), id, (size_t)cache_mb << 20, spill_path));
+	}
+	catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
+	double largest = 0;
+	if (queue != "heap" && !integral_weights(graph, largest)) { cout << "Error: the " << queue << " queue needs non-negative integer weights." << endl; return 1; }
+	if (queue == "bucket" && largest >= bucket_queue::max_spread) { cout << "Error: the weights are too large for the bucket queue." << endl; return 1; }
+	query_server server(graph, threads, semantics, queue, cache.get());
+	if (!socket_path.empty()) return listen_on(server, socket_path);
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	size_t queries = server.serve(0, 1);
+	double seconds = chrono::duration <double>(chrono::steady_clock::now() - start).count();
+	cerr << queries << " queries in " << seconds << " s (" << (seconds > 0 ? queries / seconds : 0) << " queries per second)" << endl;
+	if (cache) cerr << "tree cache: " << cache->num_hits() << " hits, " << cache->num_misses() << " misses, " << cache->num_spilled() << " trees spilled, " << cache->num_reloads() << " read back" << endl;
+
+	return 0;
+}
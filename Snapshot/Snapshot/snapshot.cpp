@@ -0,0 +1,38 @@
+/**********************************************************************************
+ * FILE:            snapshot.cpp
+ * DESCRIPTION:     This program parses an edge list once and saves it as a
+ *                  binary snapshot, that the Dijkstra, Prim and Kruskal
+ *                  programs can then map and use with no parse step.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include "../../common/snapshot.h"
+using namespace std;
+
+int main(int argc, char** argv) {
+
+	if (argc < 3) {
+		cout << "Usage: " << argv[0] << " edge_list snapshot [directed|undirected]" << endl;
+		return 1;
+	}
+	string mode = (argc > 3) ? argv[3] : "undirected";
+	if (mode != "directed" && mode != "undirected") { cout << "Unknown mode " << mode << "." << endl; return 1; }
+
+	try {
+		csr_graph graph = load_edge_list(argv[1], mode == "directed");
+		write_snapshot(graph, argv[2], mode == "directed");
+		uint64_t id;
+		csr_graph check = open_snapshot(argv[2], &id);
+		char hex[17];
+		snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)id);
+		cout << "Saved " << check.num_vertices() << " nodes and " << check.num_arcs() << " " << mode << " arcs to " << argv[2]
+			<< " (graph id " << hex << ")." << endl;
+	}
+	catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
+
+	return 0;
+}
@@ -0,0 +1,322 @@
+/**********************************************************************************
+ * FILE:            all_pairs.h
+ * DESCRIPTION:     All-pairs shortest paths for small dense graphs, by the
+ *                  Floyd-Warshall algorithm on a matrix of additive costs:
+ *                      D[i][j] = min(D[i][j], D[i][k] + D[k][j])
+ *                  The matrix is cut into tiles of tile x tile entries, and
+ *                  every round k updates the diagonal tile first, then the
+ *                  tiles of its row and column, then all the others, which
+ *                  are independent and run in parallel. Inside a tile the
+ *                  update of a row is done by one of three kernels, chosen
+ *                  when the program runs from what the processor supports:
+ *                      avx512   8 costs per instruction
+ *                      avx2     4 costs per instruction
+ *                      scalar   plain C++, on any processor and compiler
+ *                  All of them compute the same costs, bit for bit.
+ *                  Semirings that map to additive costs (semiring.h) are
+ *                  solved on their costs: -log of the safety for max_product,
+ *                  -log of 1 - risk for noisy_or. Their values are therefore
+ *                  equal to those of Dijkstra's algorithm up to rounding only.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef ALL_PAIRS_H
+#define ALL_PAIRS_H
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include "csr_graph.h"
+#include "parallel.h"
+#include "semiring.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ALL_PAIRS_X86
+#include <immintrin.h>
+#endif
+
+enum class fw_kernel { scalar, avx2, avx512 };
+
+inline const char* kernel_name(fw_kernel k) {
+	switch (k) {
+	case fw_kernel::avx512: return "avx512";
+	case fw_kernel::avx2: return "avx2";
+	default: return "scalar";
+	}
+}
+
+/*** supported() tells whether the processor can run kernel k. ***/
+inline bool supported(fw_kernel k) {
+#ifdef ALL_PAIRS_X86
+	if (k == fw_kernel::avx512) return __builtin_cpu_supports("avx512f");
+	if (k == fw_kernel::avx2) return __builtin_cpu_supports("avx2");
+#else
+	if (k != fw_kernel::scalar) return false;
+#endif
+	return true;
+}
+
+/*** best_kernel() is the widest kernel the processor can run. ***/
+inline fw_kernel best_kernel() {
+	if (supported(fw_kernel::avx512)) return fw_kernel::avx512;
+	if (supported(fw_kernel::avx2)) return fw_kernel::avx2;
+	return fw_kernel::scalar;
+}
+
+/*** parse_kernel() reads auto, scalar, avx2 or avx512. ***/
+inline fw_kernel parse_kernel(const std::string& name) {
+	if (name == "auto") return best_kernel();
+	fw_kernel k;
+	if (name == "scalar") k = fw_kernel::scalar;
+	else if (name == "avx2") k = fw_kernel::avx2;
+	else if (name == "avx512") k = fw_kernel::avx512;
+	else throw std::runtime_error("unknown kernel " + name);
+	if (!supported(k)) throw std::runtime_error("this processor cannot run the " + name + " kernel");
+	return k;
+}
+
+// the tile kernels: row i of C takes min(C[i][j], A[i][k] + B[k][j]) for every k of the tile.
+// fw_tile_closure() solves the diagonal tile, which is A, B and C at once, and must run k in
+// the outer loop. Every other tile of a round has the diagonal tile, already solved, as A or B,
+// or is neither, and then a single pass over k per row gives the same costs. So the kernels
+// take the rows of C one by one and keep the row in registers (16 ymm or 8 zmm) while k runs,
+// instead of loading and storing the whole tile for every k. AVX-512 has the registers for two
+// rows, which then share the loads of B. Each of them copies the row of A
+// before the pass, as C may be A, and adds as min(a + b, c), so that they agree bit for bit.
+static const int fw_tile = 64;
+
+inline void fw_tile_closure(double* C, size_t stride) {
+	for (int k = 0; k < fw_tile; k++) {
+		const double* b = C + k * stride;
+		for (int i = 0; i < fw_tile; i++) {
+			double a = C[i * stride + k];
+			double* c = C + i * stride;
+			for (int j = 0; j < fw_tile; j++) { c[j] = std::min(a + b[j], c[j]); }
+		}
+	}
+}
+
+inline void fw_tile_scalar(double* C, const double* A, const double* B, size_t stride) {
+	double a[fw_tile], row[fw_tile];
+	for (int i = 0; i < fw_tile; i++) {
+		double* c = C + i * stride;
+		std::copy(A + i * stride, A + i * stride + fw_tile, a);
+		std::copy(c, c + fw_tile, row);
+		for (int k = 0; k < fw_tile; k++) {
+			const double* b = B + k * stride;
+			for (int j = 0; j < fw_tile; j++) { row[j] = std::min(a[k] + b[j], row[j]); }
+		}
+		std::copy(row, row + fw_tile, c);
+	}
+}
+
+#ifdef ALL_PAIRS_X86
+__attribute__((target("avx2")))
+inline void fw_tile_avx2(double* C, const double* A, const double* B, size_t stride) {
+	double a[fw_tile];
+	for (int i = 0; i < fw_tile; i++) {
+		double* c = C + i * stride;
+		std::copy(A + i * stride, A + i * stride + fw_tile, a);
+		// half a row at a time, 8 registers, so that A and B have registers left
+		for (int h = 0; h < fw_tile; h += 32) {
+			__m256d r0 = _mm256_loadu_pd(c + h), r1 = _mm256_loadu_pd(c + h + 4);
+			__m256d r2 = _mm256_loadu_pd(c + h + 8), r3 = _mm256_loadu_pd(c + h + 12);
+			__m256d r4 = _mm256_loadu_pd(c + h + 16), r5 = _mm256_loadu_pd(c + h + 20);
+			__m256d r6 = _mm256_loadu_pd(c + h + 24), r7 = _mm256_loadu_pd(c + h + 28);
+			for (int k = 0; k < fw_tile; k++) {
+				__m256d x = _mm256_set1_pd(a[k]);
+				const double* b = B + k * stride + h;
+				r0 = _mm256_min_pd(_mm256_add_pd(x, _mm256_loadu_pd(b)), r0);
+				r1 = _mm256_min_pd(_mm256_add_pd(x, _mm256_loadu_pd(b + 4)), r1);
+				r2 = _mm256_min_pd(_mm256_add_pd(x, _mm256_loadu_pd(b + 8)), r2);
+				r3 = _mm256_min_pd(_mm256_add_pd(x, _mm256_loadu_pd(b + 12)), r3);
+				r4 = _mm256_min_pd(_mm256_add_pd(x, _mm256_loadu_pd(b + 16)), r4);
+				r5 = _mm256_min_pd(_mm256_add_pd(x, _mm256_loadu_pd(b + 20)), r5);
+				r6 = _mm256_min_pd(_mm256_add_pd(x, _mm256_loadu_pd(b + 24)), r6);
+				r7 = _mm256_min_pd(_mm256_add_pd(x, _mm256_loadu_pd(b + 28)), r7);
+			}
+			_mm256_storeu_pd(c + h, r0); _mm256_storeu_pd(c + h + 4, r1);
+			_mm256_storeu_pd(c + h + 8, r2); _mm256_storeu_pd(c + h + 12, r3);
+			_mm256_storeu_pd(c + h + 16, r4); _mm256_storeu_pd(c + h + 20, r5);
+			_mm256_storeu_pd(c + h + 24, r6); _mm256_storeu_pd(c + h + 28, r7);
+		}
+	}
+}
+
+// min(x, y) in the masked form, as the plain one trips a false warning of GCC 12
+__attribute__((target("avx512f")))
+inline __m512d fw_min512(__m512d x, __m512d y) { return _mm512_mask_min_pd(y, (__mmask8)0xFF, x, y); }
+
+// fw_row_avx512() updates row c of C, with a the row of A, in 8 registers
+__attribute__((target("avx512f")))
+inline void fw_row_avx512(double* c, const double* a, const double* B, size_t stride) {
+	__m512d r0 = _mm512_loadu_pd(c), r1 = _mm512_loadu_pd(c + 8);
+	__m512d r2 = _mm512_loadu_pd(c + 16), r3 = _mm512_loadu_pd(c + 24);
+	__m512d r4 = _mm512_loadu_pd(c + 32), r5 = _mm512_loadu_pd(c + 40);
+	__m512d r6 = _mm512_loadu_pd(c + 48), r7 = _mm512_loadu_pd(c + 56);
+	for (int k = 0; k < fw_tile; k++) {
+		__m512d x = _mm512_set1_pd(a[k]);
+		const double* b = B + k * stride;
+		r0 = fw_min512(_mm512_add_pd(x, _mm512_loadu_pd(b)), r0);
+		r1 = fw_min512(_mm512_add_pd(x, _mm512_loadu_pd(b + 8)), r1);
+		r2 = fw_min512(_mm512_add_pd(x, _mm512_loadu_pd(b + 16)), r2);
+		r3 = fw_min512(_mm512_add_pd(x, _mm512_loadu_pd(b + 24)), r3);
+		r4 = fw_min512(_mm512_add_pd(x, _mm512_loadu_pd(b + 32)), r4);
+		r5 = fw_min512(_mm512_add_pd(x, _mm512_loadu_pd(b + 40)), r5);
+		r6 = fw_min512(_mm512_add_pd(x, _mm512_loadu_pd(b + 48)), r6);
+		r7 = fw_min512(_mm512_add_pd(x, _mm512_loadu_pd(b + 56)), r7);
+	}
+	_mm512_storeu_pd(c, r0); _mm512_storeu_pd(c + 8, r1);
+	_mm512_storeu_pd(c + 16, r2); _mm512_storeu_pd(c + 24, r3);
+	_mm512_storeu_pd(c + 32, r4); _mm512_storeu_pd(c + 40, r5);
+	_mm512_storeu_pd(c + 48, r6); _mm512_storeu_pd(c + 56, r7);
+}
+
+// fw_rows_avx512() updates rows c and d of C, with a and e the rows of A, in 16 registers,
+// so that every load of B serves both
+__attribute__((target("avx512f")))
+inline void fw_rows_avx512(double* c, double* d, const double* a, const double* e, const double* B, size_t stride) {
+	__m512d r0 = _mm512_loadu_pd(c), r1 = _mm512_loadu_pd(c + 8);
+	__m512d r2 = _mm512_loadu_pd(c + 16), r3 = _mm512_loadu_pd(c + 24);
+	__m512d r4 = _mm512_loadu_pd(c + 32), r5 = _mm512_loadu_pd(c + 40);
+	__m512d r6 = _mm512_loadu_pd(c + 48), r7 = _mm512_loadu_pd(c + 56);
+	__m512d s0 = _mm512_loadu_pd(d), s1 = _mm512_loadu_pd(d + 8);
+	__m512d s2 = _mm512_loadu_pd(d + 16), s3 = _mm512_loadu_pd(d + 24);
+	__m512d s4 = _mm512_loadu_pd(d + 32), s5 = _mm512_loadu_pd(d + 40);
+	__m512d s6 = _mm512_loadu_pd(d + 48), s7 = _mm512_loadu_pd(d + 56);
+	for (int k = 0; k < fw_tile; k++) {
+		__m512d x = _mm512_set1_pd(a[k]), y = _mm512_set1_pd(e[k]);
+		const double* b = B + k * stride;
+		__m512d z;
+		z = _mm512_loadu_pd(b);
+		r0 = fw_min512(_mm512_add_pd(x, z), r0); s0 = fw_min512(_mm512_add_pd(y, z), s0);
+		z = _mm512_loadu_pd(b + 8);
+		r1 = fw_min512(_mm512_add_pd(x, z), r1); s1 = fw_min512(_mm512_add_pd(y, z), s1);
+		z = _mm512_loadu_pd(b + 16);
+		r2 = fw_min512(_mm512_add_pd(x, z), r2); s2 = fw_min512(_mm512_add_pd(y, z), s2);
+		z = _mm512_loadu_pd(b + 24);
+		r3 = fw_min512(_mm512_add_pd(x, z), r3); s3 = fw_min512(_mm512_add_pd(y, z), s3);
+		z = _mm512_loadu_pd(b + 32);
+		r4 = fw_min512(_mm512_add_pd(x, z), r4); s4 = fw_min512(_mm512_add_pd(y, z), s4);
+		z = _mm512_loadu_pd(b + 40);
+		r5 = fw_min512(_mm512_add_pd(x, z), r5); s5 = fw_min512(_mm512_add_pd(y, z), s5);
+		z = _mm512_loadu_pd(b + 48);
+		r6 = fw_min512(_mm512_add_pd(x, z), r6); s6 = fw_min512(_mm512_add_pd(y, z), s6);
+		z = _mm512_loadu_pd(b + 56);
+		r7 = fw_min512(_mm512_add_pd(x, z), r7); s7 = fw_min512(_mm512_add_pd(y, z), s7);
+	}
+	_mm512_storeu_pd(c, r0); _mm512_storeu_pd(c + 8, r1);
+	_mm512_storeu_pd(c + 16, r2); _mm512_storeu_pd(c + 24, r3);
+	_mm512_storeu_pd(c + 32, r4); _mm512_storeu_pd(c + 40, r5);
+	_mm512_storeu_pd(c + 48, r6); _mm512_storeu_pd(c + 56, r7);
+	_mm512_storeu_pd(d, s0); _mm512_storeu_pd(d + 8, s1);
+	_mm512_storeu_pd(d + 16, s2); _mm512_storeu_pd(d + 24, s3);
+	_mm512_storeu_pd(d + 32, s4); _mm512_storeu_pd(d + 40, s5);
+	_mm512_storeu_pd(d + 48, s6); _mm512_storeu_pd(d + 56, s7);
+}
+
+__attribute__((target("avx512f")))
+inline void fw_tile_avx512(double* C, const double* A, const double* B, size_t stride) {
+	double a[fw_tile], e[fw_tile];
+	// when C is B, a row must see the row above it updated, as in the other kernels
+	if (B == C) {
+		for (int i = 0; i < fw_tile; i++) {
+			std::copy(A + i * stride, A + i * stride + fw_tile, a);
+			fw_row_avx512(C + i * stride, a, B, stride);
+		}
+		return;
+	}
+	for (int i = 0; i < fw_tile; i += 2) {
+		std::copy(A + i * stride, A + i * stride + fw_tile, a);
+		std::copy(A + (i + 1) * stride, A + (i + 1) * stride + fw_tile, e);
+		fw_rows_avx512(C + i * stride, C + (i + 1) * stride, a, e, B, stride);
+	}
+}
+#endif
+
+/*** floyd_warshall() solves the n x n cost matrix D in place, rows stride apart, where n and
+stride are multiples of fw_tile. Missing arcs cost infinity and no cost may be negative. ***/
+inline void floyd_warshall(std::vector<double>& D, int n, size_t stride, fw_kernel kernel, thread_team& team) {
+	void (*update)(double*, const double*, const double*, size_t) = fw_tile_scalar;
+#ifdef ALL_PAIRS_X86
+	if (kernel == fw_kernel::avx2) update = fw_tile_avx2;
+	if (kernel == fw_kernel::avx512) update = fw_tile_avx512;
+#endif
+	int tiles = n / fw_tile;
+	auto tile = [&](int i, int j) { return D.data() + (size_t)i * fw_tile * stride + (size_t)j * fw_tile; };
+	// run fn(t) for t in [0, count) on the team
+	auto spread = [&](int count, const std::function<void(int)>& fn) {
+		std::atomic<int> next(0);
+		team.run([&](unsigned) {
+			for (int t = next.fetch_add(1); t < count; t = next.fetch_add(1)) { fn(t); }
+		});
+	};
+	for (int k = 0; k < tiles; k++) {
+		double* kk = tile(k, k);
+		fw_tile_closure(kk, stride);
+		spread(2 * tiles, [&](int t) {
+			int other = t / 2;
+			if (other == k) return;
+			if (t % 2 == 0) update(tile(k, other), kk, tile(k, other), stride);
+			else update(tile(other, k), tile(other, k), kk, stride);
+		});
+		spread(tiles * tiles, [&](int t) {
+			int i = t / tiles, j = t % tiles;
+			if (i == k || j == k) return;
+			update(tile(i, j), tile(i, k), tile(k, j), stride);
+		});
+	}
+}
+
+/*** all_pairs<S> holds the value of the best path between every two vertices of a graph, for
+a semiring with cost() and from_cost(). Vertex weights are charged as in dijkstra.h, the
+weight of the source included. ***/
+template <typename Semiring>
+class all_pairs {
+public:
+	all_pairs(const csr_graph& g, unsigned threads = 0, fw_kernel kernel = best_kernel()) : n(g.num_vertices()) {
+		int padded = (n + fw_tile - 1) / fw_tile * fw_tile;
+		stride = padded;
+		D.assign((size_t)padded * stride, std::numeric_limits<double>::infinity());
+		for (int u = 0; u < n; u++) {
+			D[(size_t)u * stride + u] = 0;
+			for (int64_t e = g.begin(u); e < g.end(u); e++) {
+				int v = g.targets[e];
+				double w = g.weights[e];
+				if (g.has_node_weights()) w = Semiring::extend(w, g.node_weight[v]);
+				double& d = D[(size_t)u * stride + v];
+				d = std::min(d, Semiring::cost(Semiring::extend(Semiring::one(), w)));
+			}
+		}
+		start.assign(n, 0.0);
+		if (g.has_node_weights()) {
+			for (int u = 0; u < n; u++) { start[u] = Semiring::cost(Semiring::extend(Semiring::one(), g.node_weight[u])); }
+		}
+		thread_team team(threads);
+		floyd_warshall(D, padded, stride, kernel, team);
+	}
+
+	int size() const { return n; }
+
+	/*** cost() is the cost of the best path from s to t, infinite if there is none. ***/
+	double cost(int s, int t) const { return start[s] + D[(size_t)s * stride + t]; }
+
+	/*** value() is the value of the best path from s to t, Semiring::zero() if there is none. ***/
+	double value(int s, int t) const {
+		double c = D[(size_t)s * stride + t];
+		if (c == std::numeric_limits<double>::infinity()) return Semiring::zero();
+		return Semiring::from_cost(start[s] + c);
+	}
+
+private:
+	int n;
+	size_t stride;
+	std::vector<double> D;			// costs without the weight of the source
+	std::vector<double> start;		// cost of the weight of every source
+};
+
+#endif
@@ -0,0 +1,123 @@
+/**********************************************************************************
+ * FILE:            arena.h
+ * DESCRIPTION:     Bump allocation for data that dies all at once: the nodes
+ *                  of the name table of a loader, or the priority queue and
+ *                  output of one query. An arena hands out memory from a few
+ *                  large blocks by moving a pointer, never frees a single
+ *                  allocation, and forgets all of them in reset(), which keeps
+ *                  the blocks for the next round.
+ *                  arena_allocator<T> lets standard containers allocate from
+ *                  an arena.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+class arena {
+public:
+	explicit arena(size_t block_size = 1 << 16) : block_size(block_size) {}
+	~arena() { release(); }
+
+	arena(const arena&) = delete;
+	arena& operator=(const arena&) = delete;
+
+	/*** allocate() returns bytes of memory aligned to align, which must be a power of 2. ***/
+	void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+		uintptr_t p = ((uintptr_t)ptr + align - 1) & ~(uintptr_t)(align - 1);
+		if (ptr == nullptr || p + bytes > (uintptr_t)limit) {
+			grow(bytes + align);
+			p = ((uintptr_t)ptr + align - 1) & ~(uintptr_t)(align - 1);
+		}
+		ptr = (char*)(p + bytes);
+		return (void*)p;
+	}
+
+	/*** allocate_array<T>() returns room for n values of T, not initialized. ***/
+	template <typename T>
+	T* allocate_array(size_t n) { return (T*)allocate(n * sizeof(T), alignof(T)); }
+
+	/*** reset() forgets every allocation. If the last round needed more than one block, they
+	are replaced by one block as large as all of them, so that the next round fits in it. ***/
+	void reset() {
+		if (blocks.size() > 1) {
+			size_t total = 0;
+			for (size_t i = 0; i < blocks.size(); i++) { total += blocks[i].size; }
+			release();
+			add_block(total);
+		}
+		if (!blocks.empty()) {
+			ptr = blocks[0].data;
+			limit = blocks[0].data + blocks[0].size;
+		}
+	}
+
+	/*** capacity() is the total size of the blocks held. ***/
+	size_t capacity() const {
+		size_t total = 0;
+		for (size_t i = 0; i < blocks.size(); i++) { total += blocks[i].size; }
+		return total;
+	}
+
+private:
+	struct block {
+		char* data;
+		size_t size;
+	};
+
+	size_t block_size;				// size of the next block, doubled every time one is added
+	std::vector<block> blocks;
+	char* ptr = nullptr;
+	char* limit = nullptr;
+
+	void grow(size_t bytes) {
+		size_t size = block_size;
+		while (size < bytes) size *= 2;
+		block_size = 2 * size;
+		add_block(size);
+	}
+
+	void add_block(size_t size) {
+		block b = { (char*)std::malloc(size), size };
+		if (b.data == nullptr) throw std::bad_alloc();
+		blocks.push_back(b);
+		ptr = b.data;
+		limit = b.data + size;
+	}
+
+	void release() {
+		for (size_t i = 0; i < blocks.size(); i++) { std::free(blocks[i].data); }
+		blocks.clear();
+		ptr = limit = nullptr;
+	}
+};
+
+/*** arena_allocator<T> allocates from an arena and frees nothing: the memory comes back when
+the arena is reset or destroyed, which must not happen while a container still uses it. ***/
+template <typename T>
+struct arena_allocator {
+	typedef T value_type;
+
+	arena* a;
+
+	explicit arena_allocator(arena& a) : a(&a) {}
+	template <typename U>
+	arena_allocator(const arena_allocator<U>& other) : a(other.a) {}
+
+	T* allocate(size_t n) { return a->allocate_array<T>(n); }
+	void deallocate(T*, size_t) {}
+
+	template <typename U>
+	bool operator==(const arena_allocator<U>& other) const { return a == other.a; }
+	template <typename U>
+	bool operator!=(const arena_allocator<U>& other) const { return a != other.a; }
+};
+
+#endif
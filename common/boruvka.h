@@ -0,0 +1,94 @@
+/**********************************************************************************
+ * FILE:            boruvka.h
+ * DESCRIPTION:     Parallel Boruvka algorithm for minimum spanning forests.
+ *                  Every round, each component picks its lightest outgoing
+ *                  edge and all picked edges are contracted at once. Edges are
+ *                  scanned by all threads together: the lightest edge of a
+ *                  component is kept in an atomic slot updated with CAS, and
+ *                  components are merged with the lock-free union-find.
+ *                  Ties are broken by edge index, so the picked edges never
+ *                  close a cycle and the result is a minimum spanning forest
+ *                  of the same cost as the one Kruskal would find.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef BORUVKA_H
+#define BORUVKA_H
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include "mst.h"
+#include "disjoint_set.h"
+#include "parallel.h"
+
+/*** boruvka_mst() returns the edges of a minimum spanning forest of the V vertices, sorted
+by ascending weight. threads = 0 uses every core. ***/
+inline std::vector<mst_edge> boruvka_mst(int V, const std::vector<mst_edge>& edges, unsigned threads = 0) {
+	if (threads == 0) threads = hardware_threads();
+	concurrent_disjoint_set sets(V);
+	std::unique_ptr<std::atomic<int64_t>[]> best(new std::atomic<int64_t>[V]);
+	std::vector<unsigned char> picked(edges.size(), 0);
+
+	// live edges still join two different components; the rest are dropped every round
+	std::vector<int64_t> live(edges.size());
+	for (size_t e = 0; e < edges.size(); e++) { live[e] = (int64_t)e; }
+	std::vector<std::vector<int64_t>> kept(threads);
+
+	auto lighter = [&](int64_t a, int64_t b) {
+		return edges[a].first < edges[b].first || (edges[a].first == edges[b].first && a < b);
+	};
+	auto offer = [&](int root, int64_t e) {
+		int64_t cur = best[root].load(std::memory_order_relaxed);
+		while ((cur == -1 || lighter(e, cur)) && !best[root].compare_exchange_weak(cur, e, std::memory_order_relaxed)) {}
+	};
+
+	while (!live.empty()) {
+		parallel_for(V, threads, [&](size_t begin, size_t end, unsigned) {
+			for (size_t v = begin; v < end; v++) { best[v].store(-1, std::memory_order_relaxed); }
+		});
+
+		// lightest outgoing edge of every component; a thread may get no chunk, so the kept
+		// edges of the last round are cleared before
+		for (unsigned t = 0; t < threads; t++) { kept[t].clear(); }
+		parallel_for(live.size(), threads, [&](size_t begin, size_t end, unsigned t) {
+			for (size_t i = begin; i < end; i++) {
+				int64_t e = live[i];
+				int ru = sets.find(edges[e].second.first);
+				int rv = sets.find(edges[e].second.second);
+				if (ru == rv) continue;
+				kept[t].push_back(e);
+				offer(ru, e);
+				offer(rv, e);
+			}
+		});
+
+		// contract: an edge picked by both of its components is united only once
+		std::atomic<int64_t> merged(0);
+		parallel_for(V, threads, [&](size_t begin, size_t end, unsigned) {
+			int64_t local = 0;
+			for (size_t v = begin; v < end; v++) {
+				int64_t e = best[v].load(std::memory_order_relaxed);
+				if (e == -1) continue;
+				if (sets.unite(edges[e].second.first, edges[e].second.second)) {
+					picked[e] = 1;
+					local++;
+				}
+			}
+			merged += local;
+		});
+		if (merged == 0) break;
+
+		live.clear();
+		for (unsigned t = 0; t < threads; t++) { live.insert(live.end(), kept[t].begin(), kept[t].end()); }
+	}
+
+	std::vector<mst_edge> F;
+	for (size_t e = 0; e < edges.size(); e++) { if (picked[e]) F.push_back(edges[e]); }
+	std::sort(F.begin(), F.end());
+	return F;
+}
+
+#endif
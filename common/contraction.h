@@ -0,0 +1,487 @@
+/**********************************************************************************
+ * FILE:            contraction.h
+ * DESCRIPTION:     Contraction Hierarchies (Geisberger, Sanders, Schultes and
+ *                  Delling). The vertices are contracted one by one, least
+ *                  important first: removing a vertex adds a shortcut between
+ *                  two of its neighbours whenever the path through it is the
+ *                  only shortest one found by a small witness search.
+ *                  Importance is the edge difference (shortcuts added minus
+ *                  arcs removed) plus the number of neighbours contracted
+ *                  already, which keeps the contraction uniform.
+ *                  A query searches upwards from the source and from the
+ *                  target, over arcs to more important vertices only, and
+ *                  settles a few hundred vertices even on large road graphs.
+ *                  The hierarchy works on additive costs: it is built for a
+ *                  semiring with cost() (see semiring.h), such as min_sum or
+ *                  the safety and risk semirings through their log transform,
+ *                  and it can be saved and loaded with the graph_id of the
+ *                  graph it was built for.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef CONTRACTION_H
+#define CONTRACTION_H
+
+#include <vector>
+#include <string>
+#include <queue>
+#include <limits>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include "arena.h"
+#include "csr_graph.h"
+#include "indexed_heap.h"
+#include "point_to_point.h"
+#include "snapshot.h"
+
+const char HIERARCHY_MAGIC[8] = { 'D', 'J', 'K', 'C', 'H', 'I', 'E', 'R' };
+const uint32_t HIERARCHY_VERSION = 1;
+
+/*** An arc of the hierarchy. middle is the vertex a shortcut skips, or -1 for an arc of
+the graph itself. ***/
+struct ch_arc {
+	double cost;
+	int target;
+	int middle;
+};
+
+struct hierarchy_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t reserved;
+	char semantics[16];		// name given to build(), checked by load()
+	uint64_t graph_id;
+	int64_t num_vertices;
+	int64_t num_up;
+	int64_t num_down;
+};
+
+class contraction_hierarchy {
+public:
+	std::vector<int> rank;				// order of contraction
+	std::vector<int64_t> up_offsets;	// n + 1 entries
+	std::vector<ch_arc> up;				// arcs v -> w with rank[w] > rank[v], by v
+	std::vector<int64_t> down_offsets;	// n + 1 entries
+	std::vector<ch_arc> down;			// arcs w -> v with rank[w] > rank[v], by v, target w
+
+	int num_vertices() const { return (int)rank.size(); }
+
+	/*** build<S>() contracts the graph, with vertex weights charged to the arcs that enter
+	them and every arc weight w turned into the cost of extend(one(), w). ***/
+	template <typename Semiring>
+	static contraction_hierarchy build(const csr_graph& g, const std::string& semantics) {
+		csr_graph folded = fold_node_weights<Semiring>(g);
+		std::vector<double> costs(folded.num_arcs());
+		for (int64_t e = 0; e < folded.num_arcs(); e++) { costs[e] = Semiring::cost(Semiring::extend(Semiring::one(), folded.weights[e])); }
+		contraction_hierarchy ch;
+		ch.contract(folded, costs);
+		ch.semantics = semantics;
+		ch.id = graph_id(g);
+		return ch;
+	}
+
+	/*** save() writes the hierarchy to path, throwing std::runtime_error on failure. ***/
+	void save(const std::string& path) const {
+		hierarchy_header h;
+		memset(&h, 0, sizeof(h));
+		memcpy(h.magic, HIERARCHY_MAGIC, sizeof(h.magic));
+		h.version = HIERARCHY_VERSION;
+		strncpy(h.semantics, semantics.c_str(), sizeof(h.semantics) - 1);
+		h.graph_id = id;
+		h.num_vertices = num_vertices();
+		h.num_up = (int64_t)up.size();
+		h.num_down = (int64_t)down.size();
+		FILE* f = fopen(path.c_str(), "wb");
+		if (f == NULL) throw std::runtime_error("cannot write " + path);
+		bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+		ok = ok && put(f, rank) && put(f, up_offsets) && put(f, up) && put(f, down_offsets) && put(f, down);
+		if (fclose(f) != 0 || !ok) throw std::runtime_error("cannot write " + path);
+	}
+
+	/*** load() reads a hierarchy saved by save(), throwing std::runtime_error if it was built
+	for another graph or with other semantics. ***/
+	static contraction_hierarchy load(const std::string& path, const csr_graph& g, const std::string& semantics) {
+		FILE* f = fopen(path.c_str(), "rb");
+		if (f == NULL) throw std::runtime_error("cannot open " + path);
+		hierarchy_header h;
+		contraction_hierarchy ch;
+		bool ok = fread(&h, sizeof(h), 1, f) == 1 && memcmp(h.magic, HIERARCHY_MAGIC, sizeof(h.magic)) == 0
+			&& h.version == HIERARCHY_VERSION;
+		if (ok && (h.graph_id != graph_id(g) || h.num_vertices != g.num_vertices())) {
+			fclose(f);
+			throw std::runtime_error(path + " was built for another graph");
+		}
+		h.semantics[sizeof(h.semantics) - 1] = '\0';
+		if (ok && semantics != h.semantics) {
+			fclose(f);
+			throw std::runtime_error(path + " was built for " + h.semantics + ", not " + semantics);
+		}
+		if (ok) {
+			ch.semantics = semantics;
+			ch.id = h.graph_id;
+			ok = get(f, ch.rank, h.num_vertices) && get(f, ch.up_offsets, h.num_vertices + 1) && get(f, ch.up, h.num_up)
+				&& get(f, ch.down_offsets, h.num_vertices + 1) && get(f, ch.down, h.num_down);
+		}
+		fclose(f);
+		if (!ok) throw std::runtime_error(path + " is not a hierarchy file");
+		return ch;
+	}
+
+	/*** find_arc() returns the cheapest arc of the hierarchy from u to v, or NULL. ***/
+	const ch_arc* find_arc(int u, int v) const {
+		const ch_arc* best = NULL;
+		if (rank[v] > rank[u]) {
+			for (int64_t e = up_offsets[u]; e < up_offsets[u + 1]; e++) {
+				if (up[e].target == v && (best == NULL || up[e].cost < best->cost)) best = &up[e];
+			}
+		}
+		else {
+			for (int64_t e = down_offsets[v]; e < down_offsets[v + 1]; e++) {
+				if (down[e].target == u && (best == NULL || down[e].cost < best->cost)) best = &down[e];
+			}
+		}
+		return best;
+	}
+
+	/*** unpack() appends to path the vertices after u on the arc u -> v of the hierarchy,
+	replacing shortcuts by the arcs they skip. ***/
+	void unpack(int u, int v, std::vector<int>& path) const {
+		const ch_arc* a = find_arc(u, v);
+		if (a->middle == -1) { path.push_back(v); return; }
+		int m = a->middle;
+		unpack(u, m, path);
+		unpack(m, v, path);
+	}
+
+private:
+	std::string semantics;
+	uint64_t id = 0;
+
+	template <typename T>
+	static bool put(FILE* f, const std::vector<T>& v) {
+		return v.empty() || fwrite(v.data(), sizeof(T), v.size(), f) == v.size();
+	}
+
+	template <typename T>
+	static bool get(FILE* f, std::vector<T>& v, int64_t n) {
+		if (n < 0) return false;
+		v.resize((size_t)n);
+		return n == 0 || fread(v.data(), sizeof(T), (size_t)n, f) == (size_t)n;
+	}
+
+	/*** The graph as it is being contracted. out[v] and in[v] hold the arcs v -> w and u -> v
+	between vertices not contracted yet, with target w and u. Once v is contracted its arcs
+	are taken out of the lists of its neighbours, so that the searches never scan them, and
+	out[v] and in[v] are left with its upward and downward arcs in the hierarchy. ***/
+	struct contraction {
+		int n;
+		std::vector<std::vector<ch_arc>> out, in;
+		std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>> position;	// arc u -> w: its index in out[u] and in in[w]
+		std::vector<int> deleted;		// neighbours contracted already
+		// witness search
+		std::vector<double> dist;
+		std::vector<int> hops;
+		std::vector<uint32_t> stamp;
+		uint32_t epoch = 0;
+		std::vector<uint32_t> goal;		// goal[w] == epoch: the current search looks for w
+		int goals = 0;					// how many of those it has not settled yet
+		arena scratch;					// the queue of the current witness search
+
+		static const int settle_limit = 500;		// witness searches give up after this many vertices
+		static const int estimate_limit = 50;	// ... and after this many when only estimating priorities
+		static const int estimate_hops = 5;		// ... in which they also follow paths of this many arcs at most
+
+		uint64_t key(int u, int w) const { return (uint64_t)u * n + w; }
+
+		/*** add() adds the arc u -> w, or lowers the cost of an existing one, which it finds
+		in position instead of scanning the arcs of u and w. ***/
+		void add(int u, int w, double cost, int middle) {
+			std::pair<std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>>::iterator, bool> ins =
+				position.emplace(key(u, w), std::make_pair((uint32_t)out[u].size(), (uint32_t)in[w].size()));
+			if (ins.second) {
+				out[u].push_back(ch_arc { cost, w, middle });
+				in[w].push_back(ch_arc { cost, u, middle });
+				return;
+			}
+			ch_arc& a = out[u][ins.first->second.first];
+			ch_arc& b = in[w][ins.first->second.second];
+			if (cost < a.cost) {
+				a.cost = b.cost = cost;
+				a.middle = b.middle = middle;
+			}
+		}
+
+		/*** detach() takes the arcs of the contracted vertex v out of the lists of its
+		neighbours, moving the last arc of a list into the hole. ***/
+		void detach(int v) {
+			for (size_t i = 0; i < in[v].size(); i++) {
+				int u = in[v][i].target;
+				uint32_t at = position[key(u, v)].first;
+				out[u][at] = out[u].back();
+				out[u].pop_back();
+				if (at < out[u].size()) position[key(u, out[u][at].target)].first = at;
+				position.erase(key(u, v));
+			}
+			for (size_t i = 0; i < out[v].size(); i++) {
+				int w = out[v][i].target;
+				uint32_t at = position[key(v, w)].second;
+				in[w][at] = in[w].back();
+				in[w].pop_back();
+				if (at < in[w].size()) position[key(in[w][at].target, w)].second = at;
+				position.erase(key(v, w));
+			}
+		}
+
+		/*** witness() runs a Dijkstra search from u, skipping skip, until the cost exceeds
+		limit, max_settled vertices are settled or every goal is, and follows no path of more
+		than max_hops arcs. Afterwards distance(w) is an upper bound of the cost from u to w
+		without going through skip. The goals are set by the caller, after the epoch is taken. ***/
+		void witness(int u, int skip, double limit, int max_settled, int max_hops) {
+			typedef std::pair<double, int> item;
+			typedef std::vector<item, arena_allocator<item>> item_vector;
+			scratch.reset();
+			std::priority_queue<item, item_vector, std::greater<item>> Q { std::greater<item>(), item_vector(arena_allocator<item>(scratch)) };
+			dist[u] = 0;
+			hops[u] = 0;
+			stamp[u] = epoch;
+			Q.push(item(0.0, u));
+			int settled = 0;
+			while (!Q.empty() && settled < max_settled) {
+				item top = Q.top();
+				Q.pop();
+				if (top.first > dist[top.second]) continue;
+				if (top.first > limit) break;
+				settled++;
+				int x = top.second;
+				if (goal[x] == epoch && --goals == 0) break;
+				if (hops[x] == max_hops) continue;
+				for (size_t i = 0; i < out[x].size(); i++) {
+					int y = out[x][i].target;
+					if (y == skip) continue;
+					double d = top.first + out[x][i].cost;
+					if (stamp[y] != epoch || d < dist[y]) {
+						dist[y] = d;
+						hops[y] = hops[x] + 1;
+						stamp[y] = epoch;
+						Q.push(item(d, y));
+					}
+				}
+			}
+		}
+
+		double distance(int w) const { return stamp[w] == epoch ? dist[w] : std::numeric_limits<double>::infinity(); }
+
+		/*** shortcuts() finds the shortcuts needed to contract v, and adds them if apply is set.
+		It returns how many there are. Estimates use shorter witness searches, limited in hops
+		too, so they may count a few shortcuts that contraction would not add. ***/
+		int shortcuts(int v, bool apply) {
+			int count = 0;
+			for (size_t i = 0; i < in[v].size(); i++) {
+				int u = in[v][i].target;
+				if (++epoch == 0) {
+					std::fill(stamp.begin(), stamp.end(), 0);
+					std::fill(goal.begin(), goal.end(), 0);
+					epoch = 1;
+				}
+				double limit = 0;
+				goals = 0;
+				for (size_t k = 0; k < out[v].size(); k++) {
+					int w = out[v][k].target;
+					if (w == u) continue;
+					limit = std::max(limit, in[v][i].cost + out[v][k].cost);
+					goal[w] = epoch;
+					goals++;
+				}
+				if (goals == 0) continue;
+				if (apply) witness(u, v, limit, settle_limit, std::numeric_limits<int>::max());
+				else witness(u, v, limit, estimate_limit, estimate_hops);
+				for (size_t k = 0; k < out[v].size(); k++) {
+					int w = out[v][k].target;
+					if (w == u) continue;
+					double through = in[v][i].cost + out[v][k].cost;
+					if (distance(w) <= through) continue;
+					count++;
+					if (apply) add(u, w, through, v);
+				}
+			}
+			return count;
+		}
+
+		double priority(int v) {
+			int removed = (int)(in[v].size() + out[v].size());
+			return (double)(shortcuts(v, false) - removed) + deleted[v];
+		}
+	};
+
+	void contract(const csr_graph& g, const std::vector<double>& costs) {
+		int n = g.num_vertices();
+		contraction C;
+		C.n = n;
+		C.out.resize(n);
+		C.in.resize(n);
+		C.deleted.assign(n, 0);
+		C.dist.resize(n);
+		C.hops.resize(n);
+		C.stamp.assign(n, 0);
+		C.goal.assign(n, 0);
+		C.position.reserve((size_t)g.num_arcs());
+		for (int u = 0; u < n; u++) {
+			for (int64_t e = g.begin(u); e < g.end(u); e++) {
+				if (g.targets[e] != u) C.add(u, g.targets[e], costs[e], -1);
+			}
+		}
+
+		// contract the vertex of lowest priority, checking first that it is still the lowest.
+		// The neighbours of a contracted vertex only have their count of deleted neighbours
+		// raised: their shortcuts are estimated again when they reach the top
+		indexed_heap<double> Q(n);
+		for (int v = 0; v < n; v++) { Q.push(v, C.priority(v)); }
+		rank.assign(n, 0);
+		int next = 0;
+		while (!Q.empty()) {
+			int v = Q.pop();
+			double p = C.priority(v);
+			if (!Q.empty() && p > Q.top_key()) { Q.push(v, p); continue; }
+			C.shortcuts(v, true);
+			C.detach(v);
+			rank[v] = next++;
+			std::vector<int> neighbours;
+			for (size_t i = 0; i < C.in[v].size(); i++) { neighbours.push_back(C.in[v][i].target); }
+			for (size_t i = 0; i < C.out[v].size(); i++) { neighbours.push_back(C.out[v][i].target); }
+			std::sort(neighbours.begin(), neighbours.end());
+			neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+			for (size_t i = 0; i < neighbours.size(); i++) {
+				int w = neighbours[i];
+				C.deleted[w]++;
+				Q.update(w, Q.key(w) + 1);
+			}
+		}
+
+		// the arcs left to every vertex are its upward ones, out[v], and downward ones, in[v]
+		up_offsets.assign(n + 1, 0);
+		down_offsets.assign(n + 1, 0);
+		for (int v = 0; v < n; v++) {
+			up_offsets[v + 1] = up_offsets[v] + (int64_t)C.out[v].size();
+			down_offsets[v + 1] = down_offsets[v] + (int64_t)C.in[v].size();
+		}
+		up.resize(up_offsets[n]);
+		down.resize(down_offsets[n]);
+		for (int v = 0; v < n; v++) {
+			std::copy(C.out[v].begin(), C.out[v].end(), up.begin() + up_offsets[v]);
+			std::copy(C.in[v].begin(), C.in[v].end(), down.begin() + down_offsets[v]);
+		}
+	}
+};
+
+/*** ch_query answers queries on a hierarchy, reusing its arrays from one query to the
+next as sssp_workspace does. Every thread needs its own. ***/
+class ch_query {
+public:
+	explicit ch_query(const contraction_hierarchy& ch) : ch(ch), n(ch.num_vertices()), F(n), B(n) {
+		for (int d = 0; d < 2; d++) {
+			dist[d].resize(n);
+			pred[d].resize(n);
+			stamp[d].assign(n, 0);
+		}
+	}
+
+	/*** cost() returns the cost of the cheapest path from source to target, or infinity. ***/
+	double cost(int source, int target) {
+		if (++epoch == 0) {
+			std::fill(stamp[0].begin(), stamp[0].end(), 0);
+			std::fill(stamp[1].begin(), stamp[1].end(), 0);
+			epoch = 1;
+		}
+		F.clear();
+		B.clear();
+		best = std::numeric_limits<double>::infinity();
+		meet = -1;
+		settled = 0;
+		label(0, source, 0.0, -1);
+		label(1, target, 0.0, -1);
+		F.push(source, 0.0);
+		B.push(target, 0.0);
+		while (true) {
+			// a direction is done once its lightest vertex cannot improve the best path
+			if (!F.empty() && F.top_key() >= best) F.clear();
+			if (!B.empty() && B.top_key() >= best) B.clear();
+			if (F.empty() && B.empty()) break;
+			int d = (B.empty() || (!F.empty() && F.top_key() <= B.top_key())) ? 0 : 1;
+			indexed_heap<double>& Q = (d == 0) ? F : B;
+			const std::vector<int64_t>& offsets = (d == 0) ? ch.up_offsets : ch.down_offsets;
+			const std::vector<ch_arc>& arcs = (d == 0) ? ch.up : ch.down;
+			int u = Q.pop();
+			settled++;
+			double du = dist[d][u];
+			if (stamp[1 - d][u] == epoch && du + dist[1 - d][u] < best) {
+				best = du + dist[1 - d][u];
+				meet = u;
+			}
+			if (stalled(d, u, du)) continue;
+			for (int64_t e = offsets[u]; e < offsets[u + 1]; e++) {
+				int v = arcs[e].target;
+				double cand = du + arcs[e].cost;
+				if (stamp[d][v] != epoch || cand < dist[d][v]) {
+					label(d, v, cand, u);
+					Q.update(v, cand);
+				}
+			}
+		}
+		return best;
+	}
+
+	/*** path() returns the vertices of the path found by the last call to cost(). ***/
+	std::vector<int> path() const {
+		std::vector<int> p;
+		if (meet == -1) return p;
+		std::vector<int> half;
+		for (int v = meet; v != -1; v = pred[0][v]) { half.push_back(v); }
+		std::reverse(half.begin(), half.end());
+		p.push_back(half[0]);
+		for (size_t i = 1; i < half.size(); i++) { ch.unpack(half[i - 1], half[i], p); }
+		for (int v = meet; pred[1][v] != -1; v = pred[1][v]) { ch.unpack(v, pred[1][v], p); }
+		return p;
+	}
+
+	/*** settled_count() is the number of vertices settled by the last call to cost(). ***/
+	int settled_count() const { return settled; }
+
+private:
+	const contraction_hierarchy& ch;
+	int n;
+	indexed_heap<double> F, B;
+	std::vector<double> dist[2];
+	std::vector<int> pred[2];
+	std::vector<uint32_t> stamp[2];
+	uint32_t epoch = 0;
+	double best;
+	int meet = -1;
+	int settled = 0;
+
+	/*** stalled() tells whether a more important vertex already labelled reaches u for less
+	than du, through an arc that this direction does not follow. Then u cannot be on the
+	best path and its arcs need not be relaxed (stall-on-demand). ***/
+	bool stalled(int d, int u, double du) const {
+		const std::vector<int64_t>& offsets = (d == 0) ? ch.down_offsets : ch.up_offsets;
+		const std::vector<ch_arc>& arcs = (d == 0) ? ch.down : ch.up;
+		for (int64_t e = offsets[u]; e < offsets[u + 1]; e++) {
+			int x = arcs[e].target;
+			if (stamp[d][x] == epoch && dist[d][x] + arcs[e].cost < du) return true;
+		}
+		return false;
+	}
+
+	void label(int d, int v, double cost, int from) {
+		dist[d][v] = cost;
+		pred[d][v] = from;
+		stamp[d][v] = epoch;
+	}
+};
+
+#endif
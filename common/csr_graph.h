@@ -0,0 +1,176 @@
+/**********************************************************************************
+ * FILE:            csr_graph.h
+ * DESCRIPTION:     Immutable weighted graph in Compressed Sparse Row layout.
+ *                  The arcs leaving vertex u are targets[offsets[u]] ..
+ *                  targets[offsets[u+1]-1], with their weights at the same
+ *                  positions of weights. Vertex names live in a side table
+ *                  that is only read when printing results.
+ *                  A csr_graph only looks at its arrays: they belong either to
+ *                  a csr_storage built in memory or to a mapped snapshot file
+ *                  (see snapshot.h), and copying a graph never copies them.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <cstdint>
+
+/*** array_view<T> is a read-only window over n contiguous values owned by someone else. ***/
+template <typename T>
+struct array_view {
+	const T* ptr = nullptr;
+	size_t len = 0;
+
+	array_view() {}
+	array_view(const T* ptr, size_t len) : ptr(ptr), len(len) {}
+	array_view(const std::vector<T>& v) : ptr(v.data()), len(v.size()) {}
+
+	const T& operator[](size_t i) const { return ptr[i]; }
+	const T* data() const { return ptr; }
+	size_t size() const { return len; }
+	bool empty() const { return len == 0; }
+	const T* begin() const { return ptr; }
+	const T* end() const { return ptr + len; }
+};
+
+/*** name_table stores all names back to back in chars; name v is chars[start[v] .. start[v+1]). ***/
+struct name_table {
+	array_view<int64_t> start;		// n + 1 entries
+	array_view<char> chars;
+
+	std::string_view operator[](size_t v) const { return std::string_view(chars.data() + start[v], (size_t)(start[v + 1] - start[v])); }
+	size_t size() const { return start.empty() ? 0 : start.size() - 1; }
+};
+
+/*** csr_storage owns the arrays of a graph built in memory. ***/
+struct csr_storage {
+	std::vector<int64_t> offsets;
+	std::vector<int> targets;
+	std::vector<double> weights;
+	std::vector<double> node_weight;
+	std::vector<int64_t> name_start;
+	std::vector<char> name_chars;
+
+	/*** add_name() appends the name of the next vertex. ***/
+	void add_name(std::string_view name) {
+		if (name_start.empty()) name_start.push_back(0);
+		name_chars.insert(name_chars.end(), name.begin(), name.end());
+		name_start.push_back((int64_t)name_chars.size());
+	}
+};
+
+struct csr_graph {
+	array_view<int64_t> offsets;		// n + 1 entries
+	array_view<int> targets;			// m entries
+	array_view<double> weights;			// m entries
+	array_view<double> node_weight;		// n entries, or empty if vertices carry no weight
+	name_table names;					// n entries, for output only
+	std::shared_ptr<const void> owner;	// keeps the arrays alive
+
+	/*** adopt() makes a graph out of arrays built in memory. ***/
+	static csr_graph adopt(csr_storage&& storage) {
+		std::shared_ptr<csr_storage> s = std::make_shared<csr_storage>(std::move(storage));
+		if (s->name_start.empty()) s->name_start.push_back(0);
+		csr_graph g;
+		g.offsets = s->offsets;
+		g.targets = s->targets;
+		g.weights = s->weights;
+		g.node_weight = s->node_weight;
+		g.names.start = s->name_start;
+		g.names.chars = s->name_chars;
+		g.owner = s;
+		return g;
+	}
+
+	int num_vertices() const { return offsets.empty() ? 0 : (int)offsets.size() - 1; }
+	int64_t num_arcs() const { return (int64_t)targets.size(); }
+	int64_t begin(int u) const { return offsets[u]; }
+	int64_t end(int u) const { return offsets[u + 1]; }
+	int degree(int u) const { return (int)(offsets[u + 1] - offsets[u]); }
+	bool has_node_weights() const { return !node_weight.empty(); }
+
+	/*** find_vertex() returns the id of the vertex with the given name, or -1. ***/
+	int find_vertex(std::string_view name) const {
+		for (size_t v = 0; v < names.size(); v++) { if (names[v] == name) return (int)v; }
+		return -1;
+	}
+};
+
+/*** graph_builder collects vertices and arcs in any order and lays them out as a
+csr_graph. The arcs of each vertex keep the order in which they were added.
+Names are stored back to back and arcs as records of one array, so building a
+graph makes a handful of large allocations however many vertices it has. ***/
+class graph_builder {
+public:
+	/*** add_vertex() returns the id of a new vertex, with an optional weight. ***/
+	int add_vertex(std::string_view name, double weight = 0.0) {
+		if (name_start.empty()) name_start.push_back(0);
+		name_chars.insert(name_chars.end(), name.begin(), name.end());
+		name_start.push_back((int64_t)name_chars.size());
+		node_weight.push_back(weight);
+		return (int)node_weight.size() - 1;
+	}
+
+	/*** add_arc() adds the directed arc u -> v of weight w. ***/
+	void add_arc(int u, int v, double w) {
+		arc a = { w, u, v };
+		arcs.push_back(a);
+	}
+
+	/*** add_edge() adds the undirected edge u -- v as two opposite arcs. ***/
+	void add_edge(int u, int v, double w) {
+		add_arc(u, v, w);
+		add_arc(v, u, w);
+	}
+
+	int num_vertices() const { return (int)node_weight.size(); }
+
+	/*** reserve() makes room for n vertices and m arcs. ***/
+	void reserve(int n, size_t m) {
+		node_weight.reserve(n);
+		name_start.reserve(n + 1);
+		arcs.reserve(m);
+	}
+
+	/*** build() counting-sorts the arcs by tail. Vertex weights are kept only if
+	with_node_weights is set. ***/
+	csr_graph build(bool with_node_weights = false) const {
+		int n = num_vertices();
+		size_t m = arcs.size();
+		csr_storage g;
+		g.offsets.assign(n + 1, 0);
+		for (size_t e = 0; e < m; e++) { g.offsets[arcs[e].tail + 1]++; }
+		for (int u = 0; u < n; u++) { g.offsets[u + 1] += g.offsets[u]; }
+		g.targets.resize(m);
+		g.weights.resize(m);
+		std::vector<int64_t> next(g.offsets.begin(), g.offsets.end() - 1);
+		for (size_t e = 0; e < m; e++) {
+			int64_t slot = next[arcs[e].tail]++;
+			g.targets[slot] = arcs[e].head;
+			g.weights[slot] = arcs[e].weight;
+		}
+		if (with_node_weights) g.node_weight = node_weight;
+		g.name_start = name_start;
+		g.name_chars = name_chars;
+		return csr_graph::adopt(std::move(g));
+	}
+
+private:
+	struct arc {
+		double weight;
+		int tail, head;
+	};
+
+	std::vector<int64_t> name_start;
+	std::vector<char> name_chars;
+	std::vector<double> node_weight;
+	std::vector<arc> arcs;
+};
+
+#endif
@@ -0,0 +1,183 @@
+/**********************************************************************************
+ * FILE:            delta_stepping.h
+ * DESCRIPTION:     Parallel single-source search by delta-stepping (Meyer and
+ *                  Sanders). Vertices are kept in buckets of width delta of
+ *                  their additive cost (see cost() in semiring.h). The bucket
+ *                  in hand is emptied by relaxing light edges, of cost up to
+ *                  delta, in parallel rounds until it stays empty; then the
+ *                  heavy edges of everything it held are relaxed once.
+ *                  Values are computed with the semiring's own extend() and
+ *                  lowered with compare-and-swap, so they are the same doubles
+ *                  the sequential engine in dijkstra.h finds.
+ *                  The vertices of a round are split among the threads, and a
+ *                  thread that runs out of work steals blocks from the others.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <cmath>
+#include <cstdint>
+#include "csr_graph.h"
+#include "semiring.h"
+#include "parallel.h"
+#include "trace.h"
+
+template <typename Semiring>
+class delta_stepping {
+public:
+	/*** delta = 0 takes the mean cost of an arc. threads = 0 uses every core. ***/
+	delta_stepping(const csr_graph& g, double delta = 0, unsigned threads = 0)
+		: g(g), team(threads), n(g.num_vertices()), value(new std::atomic<double>[g.num_vertices()]) {
+		// arc weights as seen by the semiring, with the weight of the head vertex charged
+		int64_t m = g.num_arcs();
+		arc.resize(m);
+		std::vector<double> arc_cost(m);
+		double total = 0;
+		int64_t finite = 0;			// arcs of finite cost, the only ones a path can go through
+		for (int u = 0; u < n; u++) {
+			for (int64_t e = g.begin(u); e < g.end(u); e++) {
+				double w = g.weights[e];
+				if (g.has_node_weights()) w = Semiring::extend(w, g.node_weight[g.targets[e]]);
+				arc[e] = w;
+				arc_cost[e] = Semiring::cost(Semiring::extend(Semiring::one(), w));
+				if (std::isfinite(arc_cost[e])) {
+					total += arc_cost[e];
+					finite++;
+				}
+			}
+		}
+		this->delta = (delta > 0) ? delta : (finite > 0 && total > 0 ? total / finite : 1.0);
+		light.resize(m);
+		for (int64_t e = 0; e < m; e++) { light[e] = arc_cost[e] <= this->delta; }
+		changed.resize(team.size());
+		queued.assign(n, -1);
+	}
+
+	double get_delta() const { return delta; }
+
+	/*** run() returns the value of every vertex from source; unreachable ones get zero(). ***/
+	std::vector<double> run(int source) {
+		for (int v = 0; v < n; v++) { value[v].store(Semiring::zero(), std::memory_order_relaxed); }
+		queued.assign(n, -1);
+		buckets.clear();
+		double start = Semiring::one();
+		if (g.has_node_weights()) start = Semiring::extend(start, g.node_weight[source]);
+		value[source].store(start, std::memory_order_relaxed);
+		enqueue(source);
+
+		std::vector<int> frontier, settled;
+		for (size_t i = 0; i < buckets.size(); i++) {
+			settled.clear();
+			while (!buckets[i].empty()) {
+				// the live entries of bucket i; stale ones moved to a lower bucket already
+				frontier.clear();
+				for (size_t k = 0; k < buckets[i].size(); k++) {
+					int v = buckets[i][k];
+					if (queued[v] == (int64_t)i) {
+						frontier.push_back(v);
+						queued[v] = -1;
+					}
+				}
+				buckets[i].clear();
+				settled.insert(settled.end(), frontier.begin(), frontier.end());
+				relax(frontier, true);
+			}
+			relax(settled, false);
+		}
+
+		std::vector<double> result(n);
+		for (int v = 0; v < n; v++) { result[v] = value[v].load(std::memory_order_relaxed); }
+		return result;
+	}
+
+private:
+	static const size_t block = 64;		// vertices taken at a time, also when stealing
+
+	const csr_graph& g;
+	thread_team team;
+	int n;
+	double delta;
+	std::vector<double> arc;
+	std::vector<unsigned char> light;	// arcs of cost up to delta
+	std::unique_ptr<std::atomic<double>[]> value;
+	std::vector<std::vector<int>> buckets;
+	std::vector<int64_t> queued;		// bucket where every vertex waits, or -1
+	std::vector<std::vector<int>> changed;	// vertices lowered by each thread in a round
+
+	/*** bucket_of() is the bucket of value x, or -1 if its cost is infinite, as for zero(). ***/
+	int64_t bucket_of(double x) const {
+		double c = Semiring::cost(x) / delta;
+		if (!std::isfinite(c)) return -1;
+		return (int64_t)std::floor(c);
+	}
+
+	/*** enqueue() files v in the bucket of its value. A vertex of infinite cost is left out: no
+	path through it can be better than the value of a vertex not reached. ***/
+	void enqueue(int v) {
+		int64_t b = bucket_of(value[v].load(std::memory_order_relaxed));
+		if (b < 0 || queued[v] == b) return;
+		queued[v] = b;
+		if ((size_t)b >= buckets.size()) buckets.resize(b + 1);
+		buckets[b].push_back(v);
+	}
+
+	/*** lower() sets value[v] to cand if that is better, and tells whether it did. ***/
+	bool lower(int v, double cand) {
+		double cur = value[v].load(std::memory_order_relaxed);
+		while (Semiring::better(cand, cur)) {
+			if (value[v].compare_exchange_weak(cur, cand, std::memory_order_relaxed)) return true;
+		}
+		return false;
+	}
+
+	/*** relax() relaxes the light or the heavy arcs leaving the given vertices, on all threads,
+	and then files every lowered vertex in its new bucket. ***/
+	void relax(const std::vector<int>& vertices, bool light_arcs) {
+		unsigned T = team.size();
+		size_t count = vertices.size();
+		// thread t owns the blocks [first[t], first[t+1]) and takes them from next[t]
+		std::vector<size_t> first(T + 1);
+		size_t blocks = (count + block - 1) / block;
+		for (unsigned t = 0; t <= T; t++) { first[t] = blocks * t / T; }
+		std::unique_ptr<std::atomic<size_t>[]> next(new std::atomic<size_t>[T]);
+		for (unsigned t = 0; t < T; t++) { next[t].store(first[t]); }
+
+		team.run([&](unsigned t) {
+			std::vector<int>& out = changed[t];
+			out.clear();
+			for (unsigned k = 0; k < T; k++) {
+				unsigned victim = (t + k) % T;	// own blocks first, then steal
+				while (true) {
+					size_t b = next[victim].fetch_add(1);
+					if (b >= first[victim + 1]) break;
+					size_t end = (b + 1) * block < count ? (b + 1) * block : count;
+					for (size_t i = b * block; i < end; i++) { relax_vertex(vertices[i], light_arcs, out); }
+				}
+			}
+		});
+		for (unsigned t = 0; t < T; t++) {
+			for (size_t k = 0; k < changed[t].size(); k++) { enqueue(changed[t][k]); }
+		}
+	}
+
+	void relax_vertex(int u, bool light_arcs, std::vector<int>& out) {
+		double du = value[u].load(std::memory_order_relaxed);
+		int64_t relaxed = 0;
+		for (int64_t e = g.begin(u); e < g.end(u); e++) {
+			if ((light[e] != 0) != light_arcs) continue;
+			int v = g.targets[e];
+			relaxed++;
+			if (lower(v, Semiring::extend(du, arc[e]))) out.push_back(v);
+		}
+		TRACE_ADD(relaxations, relaxed);
+		(void)relaxed;
+	}
+};
+
+#endif
@@ -0,0 +1,206 @@
+/**********************************************************************************
+ * FILE:            dijkstra.h
+ * DESCRIPTION:     Dijkstra's algorithm, generic over the path semiring (see
+ *                  semiring.h). The semiring is a template parameter, so the
+ *                  relaxation loop has no virtual calls and no std::function:
+ *                  combine and compare are inlined for every variant.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef DIJKSTRA_H
+#define DIJKSTRA_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "arena.h"
+#include "csr_graph.h"
+#include "indexed_heap.h"
+#include "semiring.h"
+#include "relax_simd.h"
+#include "trace.h"
+
+/*** Result of a search: the value and predecessor of every vertex, and the vertices in
+the order in which they were settled. Vertices never reached keep Semiring::zero().
+The per-vertex state is kept in separate arrays so that the relaxation loop only
+touches the ones it needs. ***/
+struct sssp_result {
+	std::vector<double> value;
+	std::vector<int> pred;
+	std::vector<int> settled;
+	bool reached = false;		// true if the target (if any) was settled
+};
+
+/*** sssp_workspace<S> holds the per-vertex arrays of a search, so that a thread answering
+many queries allocates them once. Instead of refilling them before every search, run()
+takes a new epoch, and an entry only counts if it was stamped in the current epoch.
+The arrays are refilled only when the epoch counter wraps around. A single stamp per
+vertex tells both whether it was reached and whether it was settled, so that relax_run()
+reads one array for both. The queue may be any with the interface of indexed_heap, such
+as the integer queues of integer_queues.h for min_sum on integer weights. ***/
+template <typename Semiring, typename Queue = indexed_heap<double, semiring_order<Semiring>>>
+class sssp_workspace {
+public:
+	/*** run() searches from source until target is settled, or over the whole graph if target
+	is -1, and tells whether target was settled (always true for -1). ***/
+	bool run(const csr_graph& g, int source, int target = -1) {
+		start(g.num_vertices());
+		double first = Semiring::one();
+		if (g.has_node_weights()) return search<true, false>(g, Semiring::extend(first, g.node_weight[source]), source, target);
+		return search<false, false>(g, first, source, target);
+	}
+
+	/*** run_folded() is run() on a graph whose vertex weights have been folded into its arcs by
+	fold_node_weights(), the weight of the source being given apart. The arcs of every vertex
+	are relaxed together by relax_run(). ***/
+	bool run_folded(const csr_graph& folded, double source_weight, int source, int target = -1) {
+		start(folded.num_vertices());
+		return search<false, true>(folded, Semiring::extend(Semiring::one(), source_weight), source, target);
+	}
+
+	double value(int v) const { return reached(v) ? value_[v] : Semiring::zero(); }
+	int pred(int v) const { return reached(v) ? pred_[v] : -1; }
+	bool is_settled(int v) const { return mark[v] == 2 * epoch + 1; }
+	const std::vector<int>& settled() const { return settled_; }
+
+	/*** path() returns the vertices from the source to v, or nothing if v was not reached. ***/
+	std::vector<int> path(int v) const {
+		std::vector<int> p;
+		if (!reached(v)) return p;
+		for (; v != -1; v = pred(v)) { p.push_back(v); }
+		std::reverse(p.begin(), p.end());
+		return p;
+	}
+
+	/*** path() with an arena does the same without a vector of its own: the path lives in the
+	arena until it is reset. ***/
+	array_view<int> path(int v, arena& a) const {
+		if (!reached(v)) return array_view<int>();
+		size_t len = 0;
+		for (int x = v; x != -1; x = pred(x)) { len++; }
+		int* p = a.allocate_array<int>(len);
+		for (size_t i = len; i > 0; v = pred(v)) { p[--i] = v; }
+		return array_view<int>(p, len);
+	}
+
+private:
+	std::vector<double> value_;
+	std::vector<int> pred_;
+	std::vector<uint32_t> mark;		// 2 * epoch: value_[v] and pred_[v] belong to this search, 2 * epoch + 1: v is also settled
+	std::vector<int> settled_;
+	Queue Q;
+	uint32_t epoch = 0;				// below 2^30, so that marks stay below 2^31 for the signed compares of relax_run_avx2()
+	std::vector<int> hits;			// for relax_run(), as long as the largest degree
+	std::vector<double> cand;
+
+	void start(int n) {
+		if ((int)mark.size() != n) {
+			value_.resize(n);
+			pred_.resize(n);
+			mark.assign(n, 0);
+			Q.resize(n);
+			epoch = 0;
+		}
+		Q.clear();
+		settled_.clear();
+		if (++epoch == 1u << 30) {
+			std::fill(mark.begin(), mark.end(), 0);
+			epoch = 1;
+		}
+	}
+
+	bool reached(int v) const { return mark[v] >= 2 * epoch; }
+
+	typedef typename Queue::key_type key_type;
+
+	template <bool NodeWeights, bool Batch>
+	bool search(const csr_graph& g, double start, int source, int target) {
+		const int64_t* offsets = g.offsets.data();
+		const int* targets = g.targets.data();
+		const double* weights = g.weights.data();
+		const double* node_weight = g.node_weight.data();
+
+		value_[source] = start;
+		pred_[source] = -1;
+		mark[source] = 2 * epoch;
+		Q.push(source, (key_type)start);
+
+		while (!Q.empty()) {
+			int u = Q.pop();
+			mark[u] = 2 * epoch + 1;
+			settled_.push_back(u);
+			if (u == target) return true;
+			double du = value_[u];
+			TRACE_ADD(relaxations, offsets[u + 1] - offsets[u]);
+			if (Batch) {
+				size_t n = offsets[u + 1] - offsets[u];
+				if (hits.size() < n) { hits.resize(n); cand.resize(n); }
+				relax_state state = { value_.data(), mark.data(), 2 * epoch };
+				size_t found = relax_run<Semiring>(du, weights + offsets[u], targets + offsets[u], n, state, hits.data(), cand.data());
+				// apply in order: an earlier arc to the same head may have improved it already
+				for (size_t k = 0; k < found; k++) {
+					int v = targets[offsets[u] + hits[k]];
+					double c = cand[hits[k]];
+					if (Semiring::better(c, reached(v) ? value_[v] : Semiring::zero())) {
+						value_[v] = c;
+						pred_[v] = u;
+						mark[v] = 2 * epoch;
+						Q.update(v, (key_type)c);
+					}
+				}
+				continue;
+			}
+			for (int64_t e = offsets[u]; e < offsets[u + 1]; e++) {
+				int v = targets[e];
+				if (mark[v] == 2 * epoch + 1) continue;
+				double w = weights[e];
+				if (NodeWeights) w = Semiring::extend(w, node_weight[v]);
+				double cand = Semiring::extend(du, w);
+				if (Semiring::better(cand, reached(v) ? value_[v] : Semiring::zero())) {
+					value_[v] = cand;
+					pred_[v] = u;
+					mark[v] = 2 * epoch;
+					Q.update(v, (key_type)cand);
+				}
+			}
+		}
+		return target == -1;
+	}
+};
+
+/*** search_result() copies the arrays of a search into an sssp_result. ***/
+template <typename Semiring, typename Queue>
+sssp_result search_result(const sssp_workspace<Semiring, Queue>& ws, int n, bool reached) {
+	sssp_result res;
+	res.reached = reached;
+	res.value.resize(n);
+	res.pred.resize(n);
+	for (int v = 0; v < n; v++) {
+		res.value[v] = ws.value(v);
+		res.pred[v] = ws.pred(v);
+	}
+	res.settled = ws.settled();
+	return res;
+}
+
+/*** dijkstra<S>() runs from source until target is settled, or over the whole graph if
+target is -1. If the graph has vertex weights, the weight of a vertex is charged every
+time a path enters it, including the source, as the hazard p of every node in
+exercise 26. The queue is chosen as in sssp_workspace. ***/
+template <typename Semiring, typename Queue = indexed_heap<double, semiring_order<Semiring>>>
+sssp_result dijkstra(const csr_graph& g, int source, int target = -1) {
+	sssp_workspace<Semiring, Queue> ws;
+	return search_result(ws, g.num_vertices(), ws.run(g, source, target));
+}
+
+/*** dijkstra_folded<S>() is dijkstra<S>() on a graph whose vertex weights were folded into
+its arcs by fold_node_weights<S>(), with the weight of the source given apart, and the arcs
+relaxed by relax_run(). ***/
+template <typename Semiring>
+sssp_result dijkstra_folded(const csr_graph& folded, double source_weight, int source, int target = -1) {
+	sssp_workspace<Semiring> ws;
+	return search_result(ws, folded.num_vertices(), ws.run_folded(folded, source_weight, source, target));
+}
+
+#endif
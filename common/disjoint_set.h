@@ -0,0 +1,130 @@
+/**********************************************************************************
+ * FILE:            disjoint_set.h
+ * DESCRIPTION:     Union-find over the integer elements 0..n-1, stored in flat
+ *                  arrays. disjoint_set uses path halving and union by rank,
+ *                  so any sequence of operations runs in almost linear time.
+ *                  concurrent_disjoint_set is a lock-free variant that many
+ *                  threads can find() and unite() on at the same time.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef DISJOINT_SET_H
+#define DISJOINT_SET_H
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include "trace.h"
+
+class disjoint_set {
+public:
+	/*** MAKE_SET(v) for every element 0..n-1. ***/
+	explicit disjoint_set(int n = 0) { reset(n); }
+
+	void reset(int n) {
+		parent.resize(n);
+		rank.assign(n, 0);
+		for (int v = 0; v < n; v++) { parent[v] = v; }
+		count = n;
+	}
+
+	int size() const { return (int)parent.size(); }
+	int num_sets() const { return count; }
+
+	/*** FIND(u) returns the representative of the set of u, halving the path on the way. ***/
+	int find(int u) {
+		TRACE_COUNT(finds);
+		while (parent[u] != u) {
+			parent[u] = parent[parent[u]];
+			u = parent[u];
+		}
+		return u;
+	}
+
+	/*** root() is FIND(u) for readers that must not disturb the structure or the counters, such
+	as the step trace: it neither counts a find nor compresses the path. ***/
+	int root(int u) const {
+		while (parent[u] != u) { u = parent[u]; }
+		return u;
+	}
+
+	/*** UNION(u, v) merges the sets of u and v. Returns false if they were already the same. ***/
+	bool unite(int u, int v) {
+		u = find(u);
+		v = find(v);
+		if (u == v) return false;
+		if (rank[u] < rank[v]) std::swap(u, v);
+		parent[v] = u;
+		if (rank[u] == rank[v]) rank[u]++;
+		count--;
+		TRACE_COUNT(unions);
+		return true;
+	}
+
+	bool same(int u, int v) { return find(u) == find(v); }
+
+private:
+	std::vector<int> parent;
+	std::vector<unsigned char> rank;	// ranks never exceed log2(n)
+	int count = 0;
+};
+
+/*** concurrent_disjoint_set links roots with compare-and-swap. A root is always hung from
+a root of larger index, which rules out cycles without any lock; finds compress paths
+with the same halving as the sequential version. ***/
+class concurrent_disjoint_set {
+public:
+	explicit concurrent_disjoint_set(int n = 0) { reset(n); }
+
+	/*** reset() is not thread-safe: call it before the threads start. ***/
+	void reset(int n) {
+		parent.reset(new std::atomic<int>[n]);
+		len = n;
+		for (int v = 0; v < n; v++) { parent[v].store(v, std::memory_order_relaxed); }
+	}
+
+	int size() const { return len; }
+
+	int find(int u) {
+		TRACE_COUNT(finds);
+		while (true) {
+			int p = parent[u].load(std::memory_order_acquire);
+			if (p == u) return u;
+			int gp = parent[p].load(std::memory_order_acquire);
+			if (p != gp) parent[u].compare_exchange_weak(p, gp, std::memory_order_acq_rel);
+			u = gp;
+		}
+	}
+
+	bool unite(int u, int v) {
+		while (true) {
+			u = find(u);
+			v = find(v);
+			if (u == v) return false;
+			if (u > v) std::swap(u, v);
+			int expected = u;
+			if (parent[u].compare_exchange_strong(expected, v, std::memory_order_acq_rel)) {
+				TRACE_COUNT(unions);
+				return true;
+			}
+		}
+	}
+
+	/*** same() is exact even while other threads unite: it retries until u's root is stable. ***/
+	bool same(int u, int v) {
+		while (true) {
+			u = find(u);
+			v = find(v);
+			if (u == v) return true;
+			if (parent[u].load(std::memory_order_acquire) == u) return false;
+		}
+	}
+
+private:
+	std::unique_ptr<std::atomic<int>[]> parent;
+	int len = 0;
+};
+
+#endif
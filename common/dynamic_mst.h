@@ -0,0 +1,325 @@
+/**********************************************************************************
+ * FILE:            dynamic_mst.h
+ * DESCRIPTION:     Minimum spanning forest kept up to date while edges arrive
+ *                  and change weight. The forest is stored in a link-cut tree
+ *                  (Sleator and Tarjan), where every edge is a node of its own
+ *                  between its endpoints, so the heaviest edge on the tree path
+ *                  between two vertices is found in O(log n) amortized time.
+ *                  A new edge joins the forest if its endpoints are apart, or
+ *                  if it is lighter than the heaviest edge of the tree path
+ *                  between them, which then leaves. Inserting an edge, making
+ *                  an edge lighter, or making an edge outside the forest
+ *                  heavier takes O(log n).
+ *                  Making a forest edge heavier may let an edge outside the
+ *                  forest replace it. Two searches over the forest, one from
+ *                  each side of the edge, take turns until the smaller side
+ *                  is known, and the lightest edge leaving it is the
+ *                  replacement: the time is that of the smaller side, which
+ *                  is the whole tree only in the worst case.
+ *                  The cost of the forest is kept as the edges change.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef DYNAMIC_MST_H
+#define DYNAMIC_MST_H
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include "mst.h"
+
+/*** link_cut_tree is a forest of rooted trees whose nodes carry a weight, with the heaviest
+node of any tree path. Every preferred path is a splay tree keyed by depth. ***/
+class link_cut_tree {
+public:
+	/*** add() makes a new tree of one node and returns the node. ***/
+	int add(float weight) {
+		node x;
+		x.weight = weight;
+		x.heaviest = (int)t.size();
+		t.push_back(x);
+		return x.heaviest;
+	}
+
+	float weight(int x) const { return t[x].weight; }
+
+	/*** set_weight() changes the weight of node x. ***/
+	void set_weight(int x, float w) {
+		access(x);
+		t[x].weight = w;
+		pull(x);
+	}
+
+	/*** connected() tells whether x and y are in the same tree. ***/
+	bool connected(int x, int y) { return x == y || find_root(x) == find_root(y); }
+
+	/*** link() joins the trees of x and y, which must be different, by an edge x - y. ***/
+	void link(int x, int y) {
+		make_root(x);
+		t[x].parent = y;
+	}
+
+	/*** cut() removes the edge x - y, which must be in the forest. ***/
+	void cut(int x, int y) {
+		make_root(x);
+		access(y);
+		t[y].child[0] = -1;
+		t[x].parent = -1;
+		pull(y);
+	}
+
+	/*** heaviest() returns the heaviest node of the path between x and y, which must be connected. ***/
+	int heaviest(int x, int y) {
+		make_root(x);
+		access(y);
+		return t[y].heaviest;
+	}
+
+private:
+	struct node {
+		int child[2] = { -1, -1 };
+		int parent = -1;			// in the splay tree, or path parent if this is a splay root
+		bool flip = false;			// the children of the subtree are to be swapped
+		float weight = 0;
+		int heaviest = -1;			// heaviest node of the splay subtree
+	};
+	std::vector<node> t;
+
+	bool is_root(int x) const {
+		int p = t[x].parent;
+		return p == -1 || (t[p].child[0] != x && t[p].child[1] != x);
+	}
+
+	void pull(int x) {
+		t[x].heaviest = x;
+		for (int c = 0; c < 2; c++) {
+			int y = t[x].child[c];
+			if (y != -1 && t[t[y].heaviest].weight > t[t[x].heaviest].weight) t[x].heaviest = t[y].heaviest;
+		}
+	}
+
+	void push(int x) {
+		if (!t[x].flip) return;
+		std::swap(t[x].child[0], t[x].child[1]);
+		for (int c = 0; c < 2; c++) {
+			if (t[x].child[c] != -1) t[t[x].child[c]].flip = !t[t[x].child[c]].flip;
+		}
+		t[x].flip = false;
+	}
+
+	void rotate(int x) {
+		int p = t[x].parent, g = t[p].parent;
+		int side = (t[p].child[1] == x);
+		int b = t[x].child[!side];
+		if (!is_root(p)) t[g].child[t[g].child[1] == p] = x;
+		t[x].parent = g;
+		t[x].child[!side] = p;
+		t[p].parent = x;
+		t[p].child[side] = b;
+		if (b != -1) t[b].parent = p;
+		pull(p);
+		pull(x);
+	}
+
+	void splay(int x) {
+		// push the pending flips down from the root of the splay tree first
+		std::vector<int>& path = scratch;
+		path.clear();
+		for (int y = x; ; y = t[y].parent) {
+			path.push_back(y);
+			if (is_root(y)) break;
+		}
+		for (size_t i = path.size(); i > 0; i--) { push(path[i - 1]); }
+		while (!is_root(x)) {
+			int p = t[x].parent;
+			if (!is_root(p)) {
+				int g = t[p].parent;
+				bool zigzig = (t[g].child[0] == p) == (t[p].child[0] == x);
+				rotate(zigzig ? p : x);
+			}
+			rotate(x);
+		}
+	}
+
+	/*** access() makes the path from the root of the tree to x preferred, and x the root of
+	its splay tree, with nothing deeper. ***/
+	void access(int x) {
+		int last = -1;
+		for (int y = x; y != -1; y = t[y].parent) {
+			splay(y);
+			t[y].child[1] = last;
+			pull(y);
+			last = y;
+		}
+		splay(x);
+	}
+
+	void make_root(int x) {
+		access(x);
+		t[x].flip = !t[x].flip;
+		push(x);
+	}
+
+	int find_root(int x) {
+		access(x);
+		while (true) {
+			push(x);
+			if (t[x].child[0] == -1) break;
+			x = t[x].child[0];
+		}
+		splay(x);
+		return x;
+	}
+
+	std::vector<int> scratch;
+};
+
+/*** dynamic_mst keeps a minimum spanning forest of the vertices 0..V-1 and the edges added
+so far. Edges are numbered in order of insertion. ***/
+class dynamic_mst {
+public:
+	explicit dynamic_mst(int V) : V(V), incident(V), side(V, 0) {
+		for (int v = 0; v < V; v++) { lct.add(-std::numeric_limits<float>::infinity()); }
+	}
+
+	int num_vertices() const { return V; }
+	int num_edges() const { return (int)edges.size(); }
+	mst_edge edge(int e) const { return edges[e].e; }
+	bool in_forest(int e) const { return edges[e].in_forest; }
+
+	/*** cost() is the total weight of the forest. ***/
+	double cost() const { return total; }
+
+	/*** replaced() is the edge that left the forest in the last change, or -1. ***/
+	int replaced() const { return left; }
+
+	/*** insert_edge() adds the edge u - v of weight w and returns its number. ***/
+	int insert_edge(int u, int v, float w) {
+		if (u < 0 || u >= V || v < 0 || v >= V) throw std::runtime_error("edge endpoint out of range");
+		int e = (int)edges.size();
+		edges.push_back(record { mst_edge(w, std::make_pair(u, v)), false });
+		lct.add(w);
+		incident[u].push_back(e);
+		if (v != u) incident[v].push_back(e);
+		left = -1;
+		offer(e);
+		return e;
+	}
+
+	/*** set_weight() changes the weight of edge e to w. ***/
+	void set_weight(int e, float w) {
+		left = -1;
+		float before = edges[e].e.first;
+		edges[e].e.first = w;
+		lct.set_weight(V + e, w);
+		if (!edges[e].in_forest) {
+			if (w < before) offer(e);
+			return;
+		}
+		total += (double)w - before;
+		if (w <= before) return;
+		// a heavier forest edge may be replaced by the lightest edge across the cut it leaves
+		remove(e);
+		int f = lightest_across(edges[e].e.second.first, edges[e].e.second.second);
+		add(f);
+		if (f != e) left = e;
+	}
+
+	/*** forest() returns the edges of the forest by ascending weight, so that tree_cost()
+	gives the same float as for the forest of kruskal_mst(). ***/
+	std::vector<mst_edge> forest() const {
+		std::vector<mst_edge> F;
+		for (size_t e = 0; e < edges.size(); e++) { if (edges[e].in_forest) F.push_back(edges[e].e); }
+		std::sort(F.begin(), F.end());
+		return F;
+	}
+
+private:
+	struct record {
+		mst_edge e;
+		bool in_forest;
+	};
+
+	int V;
+	link_cut_tree lct;			// vertices 0..V-1, then edge e as node V + e
+	std::vector<record> edges;
+	std::vector<std::vector<int>> incident;	// edges of every vertex, in the forest or not
+	std::vector<char> side;					// 1 or 2 while lightest_across() runs
+	double total = 0;
+	int left = -1;
+
+	/*** offer() puts edge e, outside the forest, in the forest if that makes the forest lighter. ***/
+	void offer(int e) {
+		int u = edges[e].e.second.first, v = edges[e].e.second.second;
+		float w = edges[e].e.first;
+		if (u != v && !lct.connected(u, v)) { add(e); return; }
+		if (u != v) {
+			int f = lct.heaviest(u, v) - V;
+			if (edges[f].e.first > w) {
+				remove(f);
+				add(e);
+				left = f;
+				return;
+			}
+		}
+	}
+
+	/*** lightest_across() returns the lightest edge between the trees of u and v, which were
+	one tree until an edge between them was removed. The two trees are searched in turns, one
+	vertex at a time, so only the smaller one is searched through. ***/
+	int lightest_across(int u, int v) {
+		std::vector<int> reached[2] = { std::vector<int>(1, u), std::vector<int>(1, v) };
+		side[u] = 1;
+		side[v] = 2;
+		size_t next[2] = { 0, 0 };
+		int small = -1;
+		while (small == -1) {
+			for (int s = 0; s < 2 && small == -1; s++) {
+				if (next[s] == reached[s].size()) { small = s; break; }
+				int x = reached[s][next[s]++];
+				for (size_t i = 0; i < incident[x].size(); i++) {
+					const record& r = edges[incident[x][i]];
+					int y = (r.e.second.first == x) ? r.e.second.second : r.e.second.first;
+					if (r.in_forest && side[y] == 0) {
+						side[y] = (char)(s + 1);
+						reached[s].push_back(y);
+					}
+				}
+			}
+		}
+		// every edge leaving the smaller tree ends in the other one
+		int best = -1;
+		for (size_t k = 0; k < reached[small].size(); k++) {
+			int x = reached[small][k];
+			for (size_t i = 0; i < incident[x].size(); i++) {
+				int f = incident[x][i];
+				int y = (edges[f].e.second.first == x) ? edges[f].e.second.second : edges[f].e.second.first;
+				if (side[y] == small + 1) continue;
+				if (best == -1 || edges[f].e.first < edges[best].e.first) best = f;
+			}
+		}
+		for (int s = 0; s < 2; s++) {
+			for (size_t k = 0; k < reached[s].size(); k++) { side[reached[s][k]] = 0; }
+		}
+		return best;
+	}
+
+	void add(int e) {
+		lct.link(edges[e].e.second.first, V + e);
+		lct.link(V + e, edges[e].e.second.second);
+		edges[e].in_forest = true;
+		total += edges[e].e.first;
+	}
+
+	void remove(int e) {
+		lct.cut(edges[e].e.second.first, V + e);
+		lct.cut(V + e, edges[e].e.second.second);
+		edges[e].in_forest = false;
+		total -= edges[e].e.first;
+	}
+};
+
+#endif
@@ -0,0 +1,282 @@
+/**********************************************************************************
+ * FILE:            dynamic_sssp.h
+ * DESCRIPTION:     Shortest path tree kept up to date while the weights of arcs
+ *                  and vertices change, in the manner of Ramalingam and Reps:
+ *                  a batch of changes only repairs the vertices whose value can
+ *                  have changed, instead of searching the whole graph again.
+ *                      1. if the source got worse, the tree loses its values,
+ *                         and every vertex takes the best one offered from
+ *                         outside it
+ *                      2. every arc whose weight changed is folded again: a
+ *                         tree arc gives its head a new value, and if it is
+ *                         worse the subtree below loses its values as in 1;
+ *                         any other arc offers its value to its head
+ *                      3. a Dijkstra search from the vertices that changed
+ *                         carries the new values as far as they improve
+ *                  Values are folded exactly as in dijkstra.h, so after every
+ *                  batch they are the same, bit for bit, as those of a search
+ *                  from scratch. Predecessors may differ between equal paths.
+ *                  A vertex settled again folds the values of its children
+ *                  again, even if they do not improve, and arcs are folded
+ *                  again whichever way their weight moved, since extend()
+ *                  rounds: a worse weight may give a better value.
+ *                  Near zero() it may even round a path below the value of its
+ *                  tail. The values then depend on the order in which a search
+ *                  settles the vertices, which a repair cannot follow, so as
+ *                  long as the tree has such an arc, or a repair meets one, the
+ *                  tree is searched again from scratch instead.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef DYNAMIC_SSSP_H
+#define DYNAMIC_SSSP_H
+
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include "csr_graph.h"
+#include "dijkstra.h"
+#include "indexed_heap.h"
+#include "semiring.h"
+
+template <typename Semiring>
+class dynamic_sssp {
+public:
+	/*** The graph is copied, so that its weights can change, and searched from source. ***/
+	dynamic_sssp(const csr_graph& g, int source) : source_(source) {
+		int n = g.num_vertices();
+		int64_t m = g.num_arcs();
+		s.offsets.assign(g.offsets.begin(), g.offsets.end());
+		s.targets.assign(g.targets.begin(), g.targets.end());
+		s.weights.assign(g.weights.begin(), g.weights.end());
+		s.node_weight.assign(g.node_weight.begin(), g.node_weight.end());
+		s.name_start.assign(g.names.start.begin(), g.names.start.end());
+		s.name_chars.assign(g.names.chars.begin(), g.names.chars.end());
+
+		// arcs entering every vertex, as indices of the arcs above
+		tails.resize(m);
+		in_offsets.assign(n + 1, 0);
+		for (int64_t e = 0; e < m; e++) { in_offsets[s.targets[e] + 1]++; }
+		for (int v = 0; v < n; v++) { in_offsets[v + 1] += in_offsets[v]; }
+		in_arcs.resize(m);
+		std::vector<int64_t> next(in_offsets.begin(), in_offsets.end() - 1);
+		for (int u = 0; u < n; u++) {
+			for (int64_t e = s.offsets[u]; e < s.offsets[u + 1]; e++) {
+				tails[e] = u;
+				in_arcs[next[s.targets[e]]++] = e;
+			}
+		}
+
+		affected.assign(n, 0);
+		Q.resize(n);
+		search();
+	}
+
+	/*** graph() is the graph with its current weights. It stays valid as long as this object,
+	and follows later changes. ***/
+	csr_graph graph() const {
+		csr_graph g;
+		g.offsets = s.offsets;
+		g.targets = s.targets;
+		g.weights = s.weights;
+		g.node_weight = s.node_weight;
+		g.names.start = s.name_start;
+		g.names.chars = s.name_chars;
+		return g;
+	}
+
+	int source() const { return source_; }
+	double value(int v) const { return value_[v]; }
+	int pred(int v) const { return pred_[v]; }
+	const std::vector<double>& values() const { return value_; }
+
+	/*** set_arc() gives weight w to every arc u -> v. It returns false if there is none. ***/
+	bool set_arc(int u, int v, double w) {
+		bool found = false;
+		for (int64_t e = s.offsets[u]; e < s.offsets[u + 1]; e++) {
+			if (s.targets[e] != v) continue;
+			found = true;
+			double before = effective(e);
+			s.weights[e] = w;
+			changed(e, before);
+		}
+		return found;
+	}
+
+	/*** set_node() gives weight p to vertex v, charged to every arc that enters it. ***/
+	void set_node(int v, double p) {
+		if (s.node_weight.empty()) throw std::runtime_error("the graph has no vertex weights");
+		std::vector<double> before(in_offsets[v + 1] - in_offsets[v]);
+		for (int64_t i = in_offsets[v]; i < in_offsets[v + 1]; i++) { before[i - in_offsets[v]] = effective(in_arcs[i]); }
+		double start_before = start();
+		s.node_weight[v] = p;
+		for (int64_t i = in_offsets[v]; i < in_offsets[v + 1]; i++) { changed(in_arcs[i], before[i - in_offsets[v]]); }
+		if (v == source_) {
+			if (Semiring::better(start_before, start())) roots.push_back(v);
+			else if (Semiring::better(start(), start_before)) source_better = true;
+		}
+	}
+
+	/*** update() repairs the tree after the changes made since the last update, and returns
+	how many vertices had to be settled again. ***/
+	int update() {
+		if (rounded) {
+			roots.clear();
+			touched.clear();
+			source_better = false;
+			return search();
+		}
+
+		// 1. the tree under a source that got worse loses its values
+		std::vector<int> lost;
+		for (size_t i = 0; i < roots.size(); i++) {
+			if (affected[roots[i]]) continue;
+			affected[roots[i]] = 1;
+			lost.push_back(roots[i]);
+		}
+		lose(lost);
+
+		// 2. the arcs that changed fold their head again
+		if (source_better) {
+			value_[source_] = start();
+			Q.update(source_, value_[source_]);
+		}
+		for (size_t i = 0; i < touched.size(); i++) { fold(touched[i], lost); }
+
+		// 3. carry the new values forward. The children of a vertex settled again are folded
+		// again from its value, as a search from scratch would: extend() rounds, so a better
+		// value need not give them a better one, and a child that gets worse loses its subtree.
+		int settled = 0;
+		while (!Q.empty() && !rounded) {
+			int u = Q.pop();
+			settled++;
+			if (!reached(u)) continue;
+			for (int64_t e = s.offsets[u]; e < s.offsets[u + 1]; e++) { fold(e, lost); }
+		}
+
+		if (rounded) {
+			Q.clear();
+			settled = search();
+		}
+		roots.clear();
+		touched.clear();
+		source_better = false;
+		return settled;
+	}
+
+private:
+	int source_;
+	csr_storage s;
+	std::vector<int64_t> in_offsets;
+	std::vector<int64_t> in_arcs;		// arcs entering each vertex, as indices into s
+	std::vector<int> tails;			// tail of every arc
+	std::vector<double> value_;
+	std::vector<int> pred_;
+	indexed_heap<double, semiring_order<Semiring>> Q;
+	std::vector<char> affected;		// in a subtree that lost its value
+	// changes since the last update
+	std::vector<int> roots;			// vertices that lose their value: the source, if it got worse
+	std::vector<int64_t> touched;	// arcs whose weight changed
+	bool source_better = false;
+	bool rounded = false;			// an arc of the tree folds a path below the value of its tail
+
+	/*** effective() is the weight of arc e with the weight of its head charged to it. ***/
+	double effective(int64_t e) const {
+		if (s.node_weight.empty()) return s.weights[e];
+		return Semiring::extend(s.weights[e], s.node_weight[s.targets[e]]);
+	}
+
+	double start() const {
+		if (s.node_weight.empty()) return Semiring::one();
+		return Semiring::extend(Semiring::one(), s.node_weight[source_]);
+	}
+
+	bool reached(int v) const { return v == source_ || pred_[v] != -1; }
+
+	/*** search() searches the tree from scratch, tells whether an arc rounds a path below the
+	value of its tail, and returns how many vertices it settled. ***/
+	int search() {
+		sssp_result r = dijkstra<Semiring>(graph(), source_);
+		value_ = r.value;
+		pred_ = r.pred;
+		rounded = false;
+		for (size_t i = 0; i < r.settled.size() && !rounded; i++) {
+			int u = r.settled[i];
+			for (int64_t e = s.offsets[u]; e < s.offsets[u + 1]; e++) {
+				if (Semiring::better(Semiring::extend(value_[u], effective(e)), value_[u])) rounded = true;
+			}
+		}
+		return (int)r.settled.size();
+	}
+
+	/*** lose() takes the value of the vertices of lost, which are marked affected, and of the
+	subtrees below them, gives each the best value offered from outside those subtrees, and
+	queues it again. ***/
+	void lose(std::vector<int>& lost) {
+		for (size_t i = 0; i < lost.size(); i++) {
+			int u = lost[i];
+			for (int64_t e = s.offsets[u]; e < s.offsets[u + 1]; e++) {
+				int v = s.targets[e];
+				if (!affected[v] && pred_[v] == u) { affected[v] = 1; lost.push_back(v); }
+			}
+		}
+		for (size_t i = 0; i < lost.size(); i++) {
+			value_[lost[i]] = Semiring::zero();
+			pred_[lost[i]] = -1;
+		}
+		for (size_t i = 0; i < lost.size(); i++) {
+			int v = lost[i];
+			if (v == source_) value_[v] = start();
+			for (int64_t k = in_offsets[v]; k < in_offsets[v + 1]; k++) {
+				int64_t e = in_arcs[k];
+				if (!affected[tails[e]]) offer(e);
+			}
+			// a vertex left without a value still leaves the queue, as it was in it
+			if (reached(v) || Q.contains(v)) Q.update(v, value_[v]);
+		}
+		for (size_t i = 0; i < lost.size(); i++) { affected[lost[i]] = 0; }
+	}
+
+	/*** changed() records that arc e had weight before and now has effective(e). ***/
+	void changed(int64_t e, double before) {
+		if (effective(e) != before) touched.push_back(e);
+	}
+
+	/*** fold() folds the value of the head of arc e again through e. If e is a tree arc, the head
+	takes that value and is queued if it got better, or loses its subtree, using lost, if it
+	got worse. Otherwise the value is only offered. ***/
+	void fold(int64_t e, std::vector<int>& lost) {
+		int u = tails[e], v = s.targets[e];
+		if (pred_[v] != u) {
+			if (offer(e)) Q.update(v, value_[v]);
+			return;
+		}
+		double cand = Semiring::extend(value_[u], effective(e));
+		if (Semiring::better(cand, value_[u])) rounded = true;
+		if (Semiring::better(cand, value_[v])) {
+			value_[v] = cand;
+			Q.update(v, cand);
+		}
+		else if (Semiring::better(value_[v], cand)) {
+			lost.assign(1, v);
+			affected[v] = 1;
+			lose(lost);
+		}
+	}
+
+	/*** offer() gives the head of arc e the value through e if it is better, and tells
+	whether it was. The source keeps its own value, as it is settled first from scratch. ***/
+	bool offer(int64_t e) {
+		int u = tails[e], v = s.targets[e];
+		if (!reached(u) || v == source_) return false;
+		double cand = Semiring::extend(value_[u], effective(e));
+		if (Semiring::better(cand, value_[u])) rounded = true;
+		if (!Semiring::better(cand, value_[v])) return false;
+		value_[v] = cand;
+		pred_[v] = u;
+		return true;
+	}
+};
+
+#endif
@@ -0,0 +1,242 @@
+/**********************************************************************************
+ * FILE:            external_kruskal.h
+ * DESCRIPTION:     Kruskal's algorithm for edge lists larger than memory, as long
+ *                  as the vertices fit (semi-external). The edge list is read in
+ *                  a single pass, in pieces of the size of the buffer, and every
+ *                  piece is sorted by weight and written to a temporary file as
+ *                  a sorted run. The runs are then merged by a k-way merge and
+ *                  the edges, coming out by ascending weight, go through an
+ *                  in-memory union-find, exactly as in kruskal_mst(). Every run
+ *                  is read in blocks, and the next block of a run is read on
+ *                  another thread while the current one is merged.
+ *                  Memory is O(V) for the vertex names, the union-find and the
+ *                  forest, plus the buffer, shared among the runs while they
+ *                  are merged.
+ *                  Vertex names must be integers, as in kruskal.cpp; the
+ *                  format is that of loader.h, and "v p" lines declare vertex v.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef EXTERNAL_KRUSKAL_H
+#define EXTERNAL_KRUSKAL_H
+
+#include <vector>
+#include <string>
+#include <queue>
+#include <future>
+#include <mutex>
+#include <memory>
+#include <algorithm>
+#include <unordered_map>
+#include <stdexcept>
+#include <cstdio>
+#include <cstdint>
+#include "loader.h"
+#include "mst.h"
+#include "disjoint_set.h"
+#include "trace.h"
+#include "mapped_file.h"
+
+/*** Result of external_kruskal(): the forest by ascending weight, on vertex indices, and the
+integer name of every index. ***/
+struct external_result {
+	std::vector<int64_t> names;
+	std::vector<mst_edge> forest;
+	uint64_t edges = 0;
+	size_t runs = 0;
+};
+
+/*** An edge as stored in the runs, ordered as mst_edge is. ***/
+struct run_edge {
+	float w;
+	int u, v;
+
+	bool operator<(const run_edge& o) const {
+		if (w != o.w) return w < o.w;
+		if (u != o.u) return u < o.u;
+		return v < o.v;
+	}
+};
+
+/*** run_file is a temporary file holding the runs back to back. It is deleted when closed. ***/
+class run_file {
+public:
+	run_file() : f(std::tmpfile()) {
+		if (f == nullptr) throw std::runtime_error("cannot create a temporary file");
+	}
+	~run_file() { std::fclose(f); }
+
+	run_file(const run_file&) = delete;
+	run_file& operator=(const run_file&) = delete;
+
+	/*** append() writes n edges at the end and returns the index of the first one. ***/
+	uint64_t append(const run_edge* e, size_t n) {
+		std::lock_guard<std::mutex> lock(m);
+		uint64_t first = size;
+		if (external_seek(f, (int64_t)(first * sizeof(run_edge)), SEEK_SET) != 0 || std::fwrite(e, sizeof(run_edge), n, f) != n) {
+			throw std::runtime_error("cannot write a temporary file");
+		}
+		size += n;
+		return first;
+	}
+
+	/*** read() reads n edges starting at edge index first. It may be called from several threads,
+	which take turns. ***/
+	void read(run_edge* e, uint64_t first, size_t n) {
+		std::lock_guard<std::mutex> lock(m);
+		if (external_seek(f, (int64_t)(first * sizeof(run_edge)), SEEK_SET) != 0 || std::fread(e, sizeof(run_edge), n, f) != n) {
+			throw std::runtime_error("cannot read a temporary file");
+		}
+	}
+
+private:
+	std::FILE* f;
+	std::mutex m;
+	uint64_t size = 0;
+};
+
+/*** run_reader hands out the edges of one run in order, with the next block being read in
+the background. ***/
+class run_reader {
+public:
+	run_reader(run_file& file, uint64_t first, uint64_t count, size_t block)
+		: file(file), next(first), end(first + count), block(block) {
+		fetch();
+		swap();
+	}
+
+	bool empty() const { return pos == current.size(); }
+	const run_edge& top() const { return current[pos]; }
+
+	void pop() {
+		if (++pos == current.size()) swap();
+	}
+
+private:
+	run_file& file;
+	uint64_t next, end;			// edges not yet asked for
+	size_t block;
+	std::vector<run_edge> current, ahead;
+	size_t pos = 0;
+	std::future<void> pending;
+
+	/*** fetch() starts reading the next block into ahead. ***/
+	void fetch() {
+		size_t n = (size_t)std::min<uint64_t>(block, end - next);
+		ahead.resize(n);
+		if (n == 0) return;
+		uint64_t first = next;
+		next += n;
+		pending = std::async(std::launch::async, [this, first, n]() { file.read(ahead.data(), first, n); });
+	}
+
+	/*** swap() waits for the block being read, makes it current and starts the next one. ***/
+	void swap() {
+		if (pending.valid()) pending.get();
+		current.swap(ahead);
+		pos = 0;
+		if (!current.empty()) fetch();
+	}
+};
+
+/*** external_kruskal() returns a minimum spanning forest of the edge list at path, using
+about buffer_bytes of memory for the edges. ***/
+inline external_result external_kruskal(const std::string& path, size_t buffer_bytes) {
+	std::FILE* in = std::fopen(path.c_str(), "rb");
+	if (in == nullptr) throw std::runtime_error("cannot open " + path);
+	std::unique_ptr<std::FILE, int (*)(std::FILE*)> closer(in, std::fclose);
+
+	external_result R;
+	std::unordered_map<int64_t, int> index;
+	auto vertex = [&](int64_t name) {
+		std::pair<std::unordered_map<int64_t, int>::iterator, bool> ins = index.emplace(name, (int)R.names.size());
+		if (ins.second) R.names.push_back(name);
+		return ins.first->second;
+	};
+
+	// 1. cut the edge list into sorted runs
+	run_file runs;
+	std::vector<std::pair<uint64_t, uint64_t>> bounds;		// first edge and length of every run
+	{
+		TRACE_PHASE("runs");
+		std::vector<run_edge> buffer;
+		buffer.reserve(std::max<size_t>(buffer_bytes / sizeof(run_edge), 1));
+		auto flush = [&]() {
+			if (buffer.empty()) return;
+			std::sort(buffer.begin(), buffer.end());
+			bounds.push_back(std::make_pair(runs.append(buffer.data(), buffer.size()), (uint64_t)buffer.size()));
+			buffer.clear();
+		};
+		std::vector<char> chunk(1 << 20);
+		std::string carry;			// a line cut by the end of the chunk
+		uint64_t line_number = 0;
+		auto parse = [&](field line) {
+			line_number++;
+			field words[3];
+			int n = split_words(line, words, 3);
+			if (n == 0 || words[0][0] == '#') return;
+			int64_t u, v;
+			double w;
+			if (n == 2 && parse_int(words[0], u)) { vertex(u); return; }
+			if (n != 3 || !parse_int(words[0], u) || !parse_int(words[1], v) || !parse_double(words[2], w)) {
+				throw std::runtime_error(path + ": bad line " + std::to_string(line_number));
+			}
+			run_edge e = { (float)w, vertex(u), vertex(v) };
+			buffer.push_back(e);
+			R.edges++;
+			if (buffer.size() == buffer.capacity()) flush();
+		};
+		size_t got;
+		while ((got = std::fread(chunk.data(), 1, chunk.size(), in)) > 0) {
+			const char* p = chunk.data();
+			const char* end = p + got;
+			const char* eol = (const char*)memchr(p, '\n', end - p);
+			if (eol == nullptr) { carry.append(p, end); continue; }
+			if (!carry.empty()) {
+				carry.append(p, eol);
+				const char* q = carry.data();
+				parse(next_line(q, carry.data() + carry.size()));
+				carry.clear();
+				p = eol + 1;
+			}
+			const char* last = end;
+			while (last > p && last[-1] != '\n') last--;
+			while (p < last) { parse(next_line(p, last)); }
+			carry.assign(last, end);
+		}
+		if (!carry.empty()) {
+			const char* q = carry.data();
+			parse(next_line(q, carry.data() + carry.size()));
+		}
+		flush();
+	}
+	R.runs = bounds.size();
+
+	// 2. merge the runs into the union-find; every run gets two blocks of the buffer
+	{
+		TRACE_PHASE("merge");
+		int V = (int)R.names.size();
+		size_t block = std::max<size_t>(buffer_bytes / sizeof(run_edge) / (2 * std::max<size_t>(bounds.size(), 1)), 4096);
+		std::vector<std::unique_ptr<run_reader>> readers;
+		for (size_t r = 0; r < bounds.size(); r++) { readers.emplace_back(new run_reader(runs, bounds[r].first, bounds[r].second, block)); }
+		typedef std::pair<run_edge, size_t> head;			// smallest edge not merged yet of a run
+		auto later = [](const head& a, const head& b) { return b.first < a.first; };
+		std::priority_queue<head, std::vector<head>, decltype(later)> Q(later);
+		for (size_t r = 0; r < readers.size(); r++) {
+			if (!readers[r]->empty()) Q.push(head(readers[r]->top(), r));
+		}
+		disjoint_set sets(V);
+		while (!Q.empty() && (int)R.forest.size() < V - 1) {
+			head h = Q.top();
+			Q.pop();
+			if (sets.unite(h.first.u, h.first.v)) R.forest.push_back(mst_edge(h.first.w, std::make_pair(h.first.u, h.first.v)));
+			run_reader& reader = *readers[h.second];
+			reader.pop();
+			if (!reader.empty()) Q.push(head(reader.top(), h.second));
+		}
+	}
+	return R;
+}
+
+#endif
@@ -0,0 +1,118 @@
+/**********************************************************************************
+ * FILE:            filter_kruskal.h
+ * DESCRIPTION:     Filter-Kruskal: Kruskal's algorithm without sorting edges
+ *                  that turn out to close cycles. The edges are split around a
+ *                  pivot weight; the light part is solved first, then every
+ *                  heavy edge whose endpoints are already connected is dropped
+ *                  before the heavy part is solved. On dense graphs most heavy
+ *                  edges are dropped unsorted. Partitioning and filtering of
+ *                  large ranges are split across threads.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef FILTER_KRUSKAL_H
+#define FILTER_KRUSKAL_H
+
+#include <vector>
+#include <algorithm>
+#include "mst.h"
+#include "disjoint_set.h"
+#include "parallel.h"
+
+class filter_kruskal {
+public:
+	filter_kruskal(int V, unsigned threads) : V(V), threads(threads == 0 ? hardware_threads() : threads), sets(V) {}
+
+	/*** run() returns the edges of a minimum spanning forest by ascending weight. ***/
+	std::vector<mst_edge> run(std::vector<mst_edge> edges) {
+		F.clear();
+		tmp.resize(edges.size());
+		solve(edges, 0, edges.size());
+		return F;
+	}
+
+private:
+	static const size_t base_size = 1 << 12;	// ranges this small are simply sorted
+	static const size_t parallel_size = 1 << 16;	// ranges this large use every thread
+
+	int V;
+	unsigned threads;
+	concurrent_disjoint_set sets;	// finds run in parallel while filtering
+	std::vector<mst_edge> F;
+	std::vector<mst_edge> tmp;
+
+	bool done() const { return (int)F.size() >= V - 1; }
+
+	/*** kruskal() is the plain algorithm on the range [begin, end). ***/
+	void kruskal(std::vector<mst_edge>& edges, size_t begin, size_t end) {
+		std::sort(edges.begin() + begin, edges.begin() + end);
+		for (size_t i = begin; i < end && !done(); i++) {
+			if (sets.unite(edges[i].second.first, edges[i].second.second)) F.push_back(edges[i]);
+		}
+	}
+
+	void solve(std::vector<mst_edge>& edges, size_t begin, size_t end) {
+		if (done() || begin == end) return;
+		if (end - begin <= base_size) { kruskal(edges, begin, end); return; }
+		float pivot = median_of_three(edges, begin, end);
+		size_t mid = split(edges, begin, end, [pivot](const mst_edge& e) { return e.first < pivot; });
+		if (mid == begin) {
+			// the pivot is the lightest weight: take all the edges of that weight as the light part
+			mid = split(edges, begin, end, [pivot](const mst_edge& e) { return e.first <= pivot; });
+			if (mid == end) { kruskal(edges, begin, end); return; }
+		}
+		solve(edges, begin, mid);
+		if (done()) return;
+		size_t kept = split(edges, mid, end, [this](const mst_edge& e) { return !sets.same(e.second.first, e.second.second); });
+		solve(edges, mid, kept);
+	}
+
+	float median_of_three(std::vector<mst_edge>& edges, size_t begin, size_t end) const {
+		float a = edges[begin].first, b = edges[begin + (end - begin) / 2].first, c = edges[end - 1].first;
+		return std::max(std::min(a, b), std::min(std::max(a, b), c));
+	}
+
+	/*** split() moves the edges of [begin, end) that satisfy pred to the front, keeping the
+	relative order within each side, and returns where the others start. Large ranges are
+	cut in one block per thread: each block counts its edges, then copies them to their place. ***/
+	template <typename Pred>
+	size_t split(std::vector<mst_edge>& edges, size_t begin, size_t end, Pred pred) {
+		size_t n = end - begin;
+		unsigned T = (n >= parallel_size) ? threads : 1;
+		std::vector<size_t> yes(T + 1, 0), no(T + 1, 0);
+		std::vector<unsigned char> mark(n);
+		parallel_for(n, T, [&](size_t b, size_t e, unsigned t) {
+			size_t count = 0;
+			for (size_t i = b; i < e; i++) {
+				mark[i] = pred(edges[begin + i]) ? 1 : 0;
+				count += mark[i];
+			}
+			yes[t + 1] = count;
+			no[t + 1] = (e - b) - count;
+		});
+		for (unsigned t = 0; t < T; t++) { yes[t + 1] += yes[t]; }
+		for (unsigned t = 0; t < T; t++) { no[t + 1] += no[t]; }
+		size_t mid = yes[T];
+		parallel_for(n, T, [&](size_t b, size_t e, unsigned t) {
+			size_t y = yes[t], x = mid + no[t];
+			for (size_t i = b; i < e; i++) {
+				if (mark[i]) tmp[begin + y++] = edges[begin + i];
+				else tmp[begin + x++] = edges[begin + i];
+			}
+		});
+		parallel_for(n, T, [&](size_t b, size_t e, unsigned) {
+			std::copy(tmp.begin() + begin + b, tmp.begin() + begin + e, edges.begin() + begin + b);
+		});
+		return begin + mid;
+	}
+};
+
+/*** filter_kruskal_mst() returns the edges of a minimum spanning forest by ascending weight.
+threads = 0 uses every core. ***/
+inline std::vector<mst_edge> filter_kruskal_mst(int V, const std::vector<mst_edge>& edges, unsigned threads = 0) {
+	filter_kruskal fk(V, threads);
+	return fk.run(edges);
+}
+
+#endif
@@ -0,0 +1,134 @@
+/**********************************************************************************
+ * FILE:            generators.h
+ * DESCRIPTION:     Synthetic undirected graphs for benchmarks, as edge lists of
+ *                  mst_edge with weights in (0, 1], so that the same graph can
+ *                  be read as distances, as safety probabilities or as risks.
+ *                      rmat_graph        power-law graph (Chakrabarti, Zhan and
+ *                                        Faloutsos), with duplicate edges
+ *                      grid_graph        road-like grid with random weights
+ *                      geometric_graph   random points of the unit square joined
+ *                                        when close, weighted by distance
+ *                      complete_graph    every pair of vertices
+ *                  The same seed always gives the same graph.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef GENERATORS_H
+#define GENERATORS_H
+
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include "csr_graph.h"
+#include "mst.h"
+
+/*** A generated graph: V vertices 0..V-1 and its undirected edges. ***/
+struct generated_graph {
+	int V = 0;
+	std::vector<mst_edge> edges;
+};
+
+/*** random_weight() draws a weight uniformly from (0, 1]. ***/
+inline float random_weight(std::mt19937_64& random) {
+	std::uniform_real_distribution<float> u(0.0f, 1.0f);
+	return 1.0f - u(random);
+}
+
+/*** rmat_graph() has 2^scale vertices and edge_factor edges per vertex, each one placed by
+choosing a quadrant of the adjacency matrix scale times with probabilities a, b, c and
+1 - a - b - c. Self loops are dropped. ***/
+inline generated_graph rmat_graph(int scale, int edge_factor, uint64_t seed, double a = 0.57, double b = 0.19, double c = 0.19) {
+	generated_graph G;
+	G.V = 1 << scale;
+	std::mt19937_64 random(seed);
+	std::uniform_real_distribution<double> coin(0.0, 1.0);
+	int64_t m = (int64_t)edge_factor * G.V;
+	G.edges.reserve(m);
+	for (int64_t e = 0; e < m; e++) {
+		int u = 0, v = 0;
+		for (int bit = 0; bit < scale; bit++) {
+			double r = coin(random);
+			int right = (r >= a && r < a + b) || r >= a + b + c;
+			int down = r >= a + b;
+			u |= down << bit;
+			v |= right << bit;
+		}
+		if (u != v) G.edges.push_back(mst_edge(random_weight(random), std::make_pair(u, v)));
+	}
+	return G;
+}
+
+/*** grid_graph() is a rows x cols grid where every vertex is joined to its right and lower
+neighbours. ***/
+inline generated_graph grid_graph(int rows, int cols, uint64_t seed) {
+	generated_graph G;
+	G.V = rows * cols;
+	std::mt19937_64 random(seed);
+	for (int i = 0; i < rows; i++) {
+		for (int j = 0; j < cols; j++) {
+			int v = i * cols + j;
+			if (j + 1 < cols) G.edges.push_back(mst_edge(random_weight(random), std::make_pair(v, v + 1)));
+			if (i + 1 < rows) G.edges.push_back(mst_edge(random_weight(random), std::make_pair(v, v + cols)));
+		}
+	}
+	return G;
+}
+
+/*** geometric_graph() places n random points in the unit square and joins the pairs closer
+than the radius that gives the requested average degree. The weight of an edge is its
+length divided by that radius. Points are bucketed in cells of the size of the radius,
+so only neighbouring cells are compared. ***/
+inline generated_graph geometric_graph(int n, double degree, uint64_t seed) {
+	generated_graph G;
+	G.V = n;
+	std::mt19937_64 random(seed);
+	std::uniform_real_distribution<double> coord(0.0, 1.0);
+	std::vector<double> x(n), y(n);
+	for (int v = 0; v < n; v++) { x[v] = coord(random); y[v] = coord(random); }
+	double r = std::sqrt(degree / (3.14159265358979 * n));
+	int cells = std::max(1, (int)(1.0 / r));
+	std::vector<std::vector<int>> cell(cells * cells);
+	auto cell_of = [&](double c) { return std::min(cells - 1, (int)(c * cells)); };
+	for (int v = 0; v < n; v++) { cell[cell_of(x[v]) * cells + cell_of(y[v])].push_back(v); }
+	for (int v = 0; v < n; v++) {
+		int cx = cell_of(x[v]), cy = cell_of(y[v]);
+		for (int i = std::max(0, cx - 1); i <= std::min(cells - 1, cx + 1); i++) {
+			for (int j = std::max(0, cy - 1); j <= std::min(cells - 1, cy + 1); j++) {
+				const std::vector<int>& C = cell[i * cells + j];
+				for (size_t k = 0; k < C.size(); k++) {
+					int w = C[k];
+					if (w <= v) continue;
+					double d = std::hypot(x[v] - x[w], y[v] - y[w]);
+					if (d < r) G.edges.push_back(mst_edge(std::max((float)(d / r), 1e-6f), std::make_pair(v, w)));
+				}
+			}
+		}
+	}
+	return G;
+}
+
+/*** complete_graph() joins every pair of the n vertices. ***/
+inline generated_graph complete_graph(int n, uint64_t seed) {
+	generated_graph G;
+	G.V = n;
+	std::mt19937_64 random(seed);
+	G.edges.reserve((size_t)n * (n - 1) / 2);
+	for (int u = 0; u < n; u++) {
+		for (int v = u + 1; v < n; v++) { G.edges.push_back(mst_edge(random_weight(random), std::make_pair(u, v))); }
+	}
+	return G;
+}
+
+/*** to_csr() lays out a generated graph as a csr_graph, every edge as two opposite arcs and
+every vertex named by its number. ***/
+inline csr_graph to_csr(const generated_graph& G) {
+	graph_builder B;
+	for (int v = 0; v < G.V; v++) { B.add_vertex(std::to_string(v)); }
+	for (size_t e = 0; e < G.edges.size(); e++) { B.add_edge(G.edges[e].second.first, G.edges[e].second.second, G.edges[e].first); }
+	return B.build();
+}
+
+#endif
@@ -0,0 +1,137 @@
+/**********************************************************************************
+ * FILE:            indexed_heap.h
+ * DESCRIPTION:     Indexed d-ary heap over the integer vertices 0..n-1. Every
+ *                  vertex keeps its position inside the heap array, so a key
+ *                  can be moved towards the top (decrease_key) or away from
+ *                  it (increase_key) in O(log_d n) without searching for it.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include "trace.h"
+
+/*** indexed_heap<Key, Compare, Arity> keeps at the top the vertex whose key is "best"
+according to Compare: std::less gives a min-heap and std::greater a max-heap. Following
+that convention, decrease_key() means "move towards the top", whatever the comparison. ***/
+template <typename Key, typename Compare = std::less<Key>, int Arity = 4>
+class indexed_heap {
+	static_assert(Arity >= 2, "indexed_heap needs an arity of at least 2");
+
+public:
+	typedef Key key_type;
+
+	explicit indexed_heap(int n = 0, Compare comp = Compare()) : comp(comp) { resize(n); }
+
+	/*** resize() prepares the position map for vertices 0..n-1 and empties the heap. ***/
+	void resize(int n) {
+		heap.clear();
+		pos.assign(n, -1);
+		keys.resize(n);
+	}
+
+	bool empty() const { return heap.empty(); }
+	int size() const { return (int)heap.size(); }
+	int capacity() const { return (int)pos.size(); }
+	bool contains(int v) const { return pos[v] != -1; }
+	const Key& key(int v) const { return keys[v]; }
+	int top() const { return heap[0]; }
+	const Key& top_key() const { return keys[heap[0]]; }
+
+	/*** push() inserts vertex v, which must not be in the heap, with the given key. ***/
+	void push(int v, const Key& k) {
+		TRACE_COUNT(heap_pushes);
+		keys[v] = k;
+		pos[v] = (int)heap.size();
+		heap.push_back(v);
+		sift_up(pos[v]);
+	}
+
+	/*** pop() removes the top vertex and returns it. ***/
+	int pop() {
+		TRACE_COUNT(heap_pops);
+		int v = heap[0];
+		int last = heap.back();
+		heap.pop_back();
+		pos[v] = -1;
+		if (!heap.empty()) {
+			heap[0] = last;
+			pos[last] = 0;
+			sift_down(0);
+		}
+		return v;
+	}
+
+	/*** decrease_key() gives v a key that is at least as good as its current one. ***/
+	void decrease_key(int v, const Key& k) {
+		TRACE_COUNT(decrease_keys);
+		keys[v] = k;
+		sift_up(pos[v]);
+	}
+
+	/*** increase_key() gives v a key that is at most as good as its current one. ***/
+	void increase_key(int v, const Key& k) {
+		keys[v] = k;
+		sift_down(pos[v]);
+	}
+
+	/*** update() changes the key of v in either direction, inserting v if it is not in the heap. ***/
+	void update(int v, const Key& k) {
+		if (!contains(v)) { push(v, k); return; }
+		if (comp(k, keys[v])) decrease_key(v, k);
+		else increase_key(v, k);
+	}
+
+	/*** clear() empties the heap touching only the vertices still inside it. ***/
+	void clear() {
+		for (size_t i = 0; i < heap.size(); i++) { pos[heap[i]] = -1; }
+		heap.clear();
+	}
+
+private:
+	std::vector<int> heap;		// vertices laid out as an implicit d-ary tree
+	std::vector<int> pos;		// pos[v] is the index of v in heap, or -1
+	std::vector<Key> keys;		// keys[v] is the current key of v
+	Compare comp;
+
+	void place(int i, int v) {
+		heap[i] = v;
+		pos[v] = i;
+	}
+
+	void sift_up(int i) {
+		int v = heap[i];
+		while (i > 0) {
+			int parent = (i - 1) / Arity;
+			if (!comp(keys[v], keys[heap[parent]])) break;
+			place(i, heap[parent]);
+			i = parent;
+		}
+		place(i, v);
+	}
+
+	void sift_down(int i) {
+		int v = heap[i];
+		int n = (int)heap.size();
+		while (true) {
+			int first = Arity * i + 1;
+			if (first >= n) break;
+			int last = (first + Arity < n) ? first + Arity : n;
+			int best = first;
+			for (int c = first + 1; c < last; c++) {
+				if (comp(keys[heap[c]], keys[heap[best]])) best = c;
+			}
+			if (!comp(keys[heap[best]], keys[v])) break;
+			place(i, heap[best]);
+			i = best;
+		}
+		place(i, v);
+	}
+};
+
+#endif
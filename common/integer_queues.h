@@ -0,0 +1,357 @@
+/**********************************************************************************
+ * FILE:            integer_queues.h
+ * DESCRIPTION:     Priority queues for integer keys, which replace comparisons
+ *                  between keys by arithmetic on them. Both keep the smallest
+ *                  key at the top and offer the interface of indexed_heap that
+ *                  Dijkstra's and Prim's algorithms use:
+ *                      radix_heap     monotone: no key may be pushed below the
+ *                                     last one popped, as in Dijkstra's
+ *                                     algorithm with min_sum. A key lives in
+ *                                     the bucket of the highest bit in which
+ *                                     it differs from the last key popped, so
+ *                                     it moves down at most 64 times:
+ *                                     O(E + V log C) for arc weights up to C.
+ *                      bucket_queue   Dial's queue: one bucket per key, in a
+ *                                     circle as long as the spread of the keys
+ *                                     waiting, which is at most the largest
+ *                                     arc weight in Dijkstra's algorithm and in
+ *                                     Prim's. Keys need not be monotone, as
+ *                                     long as they stay within that spread,
+ *                                     and the circle grows if they do not. A
+ *                                     bit per bucket tells the ones not empty,
+ *                                     so that a pop skips 64 empty buckets at
+ *                                     a time.
+ *                  Weights that are not integers can be scaled and rounded by
+ *                  quantize_weights() first.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef INTEGER_QUEUES_H
+#define INTEGER_QUEUES_H
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <stdexcept>
+#include "csr_graph.h"
+#include "trace.h"
+
+/*** highest_bit() is the position of the highest bit set in x, which is not zero. ***/
+inline int highest_bit(uint64_t x) {
+#ifdef __GNUC__
+	return 63 - __builtin_clzll(x);
+#else
+	int b = 0;
+	while (x >>= 1) { b++; }
+	return b;
+#endif
+}
+
+/*** lowest_bit() is the position of the lowest bit set in x, which is not zero. ***/
+inline int lowest_bit(uint64_t x) {
+#ifdef __GNUC__
+	return __builtin_ctzll(x);
+#else
+	int b = 0;
+	while (!(x & 1)) { x >>= 1; b++; }
+	return b;
+#endif
+}
+
+/*** radix_heap is a monotone min-queue of the vertices 0..n-1 keyed by integers. ***/
+class radix_heap {
+public:
+	typedef uint64_t key_type;
+
+	explicit radix_heap(int n = 0) { resize(n); }
+
+	/*** resize() prepares the queue for vertices 0..n-1 and empties it. ***/
+	void resize(int n) {
+		for (int b = 0; b < buckets; b++) { bucket[b].clear(); }
+		where.assign(n, -1);
+		slot.resize(n);
+		keys.resize(n);
+		count = 0;
+		last = 0;
+	}
+
+	bool empty() const { return count == 0; }
+	int size() const { return count; }
+	bool contains(int v) const { return where[v] != -1; }
+
+	/*** key() is the key of v, which stays readable after v is popped. ***/
+	key_type key(int v) const { return keys[v]; }
+
+	/*** push() inserts vertex v, which must not be in the queue, with a key no smaller than
+	the last one popped. ***/
+	void push(int v, key_type k) {
+		TRACE_COUNT(heap_pushes);
+		if (count == 0 && k < last) last = k;
+		if (k < last) throw std::runtime_error("radix_heap: key below the last one popped");
+		keys[v] = k;
+		place(v, index(k));
+		count++;
+	}
+
+	/*** pop() removes a vertex of the smallest key and returns it. ***/
+	int pop() {
+		TRACE_COUNT(heap_pops);
+		if (bucket[0].empty()) {
+			// the smallest key of the first bucket not empty becomes the last key, and all the
+			// keys of that bucket now differ from it in lower bits
+			int b = 1;
+			while (bucket[b].empty()) { b++; }
+			std::vector<int>& from = bucket[b];
+			key_type low = keys[from[0]];
+			for (size_t i = 1; i < from.size(); i++) { if (keys[from[i]] < low) low = keys[from[i]]; }
+			last = low;
+			std::vector<int> moving;
+			moving.swap(from);
+			for (size_t i = 0; i < moving.size(); i++) { place(moving[i], index(keys[moving[i]])); }
+			moving.clear();
+			moving.swap(from);			// keep the storage of the bucket
+		}
+		int v = bucket[0].back();
+		bucket[0].pop_back();
+		where[v] = -1;
+		count--;
+		return v;
+	}
+
+	/*** decrease_key() gives v a key no larger than its current one, and no smaller than the
+	last key popped. ***/
+	void decrease_key(int v, key_type k) {
+		TRACE_COUNT(decrease_keys);
+		if (k < last) throw std::runtime_error("radix_heap: key below the last one popped");
+		remove(v);
+		keys[v] = k;
+		place(v, index(k));
+	}
+
+	/*** update() lowers the key of v, inserting v if it is not in the queue. ***/
+	void update(int v, key_type k) {
+		if (!contains(v)) push(v, k);
+		else if (k < keys[v]) decrease_key(v, k);
+	}
+
+	/*** clear() empties the queue touching only the vertices still inside it. ***/
+	void clear() {
+		for (int b = 0; b < buckets; b++) {
+			for (size_t i = 0; i < bucket[b].size(); i++) { where[bucket[b][i]] = -1; }
+			bucket[b].clear();
+		}
+		count = 0;
+		last = 0;
+	}
+
+private:
+	static const int buckets = 65;		// equal to last, then highest differing bit 0..63
+	std::vector<int> bucket[buckets];
+	std::vector<signed char> where;		// bucket of every vertex, or -1
+	std::vector<int> slot;				// position of every vertex in its bucket
+	std::vector<key_type> keys;
+	int count = 0;
+	key_type last = 0;					// last key popped
+
+	int index(key_type k) const { return k == last ? 0 : highest_bit(k ^ last) + 1; }
+
+	void place(int v, int b) {
+		where[v] = (signed char)b;
+		slot[v] = (int)bucket[b].size();
+		bucket[b].push_back(v);
+	}
+
+	void remove(int v) {
+		std::vector<int>& from = bucket[where[v]];
+		int moved = from.back();
+		from[slot[v]] = moved;
+		slot[moved] = slot[v];
+		from.pop_back();
+		where[v] = -1;
+	}
+};
+
+/*** bucket_queue is Dial's min-queue of the vertices 0..n-1 keyed by integers, for keys that
+are never further than a bounded spread apart. ***/
+class bucket_queue {
+public:
+	typedef uint64_t key_type;
+	static const key_type max_spread = key_type(1) << 26;		// most buckets it will make
+
+	explicit bucket_queue(int n = 0) { resize(n); }
+
+	/*** resize() prepares the queue for vertices 0..n-1 and empties it. ***/
+	void resize(int n) {
+		bucket.assign(16, std::vector<int>());
+		mask = 15;
+		occupied.assign(1, 0);
+		filled.clear();
+		inside.assign(n, 0);
+		slot.resize(n);
+		keys.resize(n);
+		count = 0;
+	}
+
+	bool empty() const { return count == 0; }
+	int size() const { return count; }
+	bool contains(int v) const { return inside[v] != 0; }
+
+	/*** key() is the key of v, which stays readable after v is popped. ***/
+	key_type key(int v) const { return keys[v]; }
+
+	/*** push() inserts vertex v, which must not be in the queue, with the given key. ***/
+	void push(int v, key_type k) {
+		TRACE_COUNT(heap_pushes);
+		if (count == 0) {
+			low = high = k;
+			filled.clear();			// every bucket is empty
+		}
+		reach(k);
+		keys[v] = k;
+		place(v);
+		count++;
+	}
+
+	/*** pop() removes a vertex of the smallest key and returns it. ***/
+	int pop() {
+		TRACE_COUNT(heap_pops);
+		// every bucket holds a single key between low and high, so the first one not empty
+		// from low on holds the smallest
+		low += next_filled((size_t)(low & mask));
+		size_t at = (size_t)(low & mask);
+		std::vector<int>& b = bucket[at];
+		int v = b.back();
+		b.pop_back();
+		if (b.empty()) occupied[at >> 6] &= ~(uint64_t(1) << (at & 63));
+		inside[v] = 0;
+		count--;
+		return v;
+	}
+
+	/*** decrease_key() gives v a key no larger than its current one. ***/
+	void decrease_key(int v, key_type k) {
+		TRACE_COUNT(decrease_keys);
+		remove(v);
+		reach(k);
+		keys[v] = k;
+		place(v);
+	}
+
+	/*** update() lowers the key of v, inserting v if it is not in the queue. ***/
+	void update(int v, key_type k) {
+		if (!contains(v)) push(v, k);
+		else if (k < keys[v]) decrease_key(v, k);
+	}
+
+	/*** clear() empties the queue touching only the buckets filled since it was last cleared,
+	not the whole circle. ***/
+	void clear() {
+		for (size_t k = 0; k < filled.size(); k++) {
+			std::vector<int>& b = bucket[filled[k]];
+			for (size_t i = 0; i < b.size(); i++) { inside[b[i]] = 0; }
+			b.clear();
+			occupied[filled[k] >> 6] = 0;
+		}
+		filled.clear();
+		count = 0;
+	}
+
+private:
+	std::vector<std::vector<int>> bucket;	// key k in bucket k & mask
+	key_type mask;
+	std::vector<uint64_t> occupied;			// bit b set if bucket b is not empty
+	std::vector<size_t> filled;				// buckets that were empty when a vertex entered them
+	std::vector<char> inside;				// 1 if the vertex is in the queue
+	std::vector<int> slot;					// position of every vertex in its bucket
+	std::vector<key_type> keys;
+	int count = 0;
+	key_type low = 0, high = 0;				// no key waiting is outside [low, high]
+
+	/*** reach() widens [low, high] to take k, and the circle of buckets with it. ***/
+	void reach(key_type k) {
+		if (k < low) low = k;
+		if (k > high) high = k;
+		if (high - low <= mask) return;
+		if (high - low >= max_spread) throw std::runtime_error("bucket_queue: keys too far apart, a radix_heap is needed");
+		size_t n = bucket.size();
+		while (n - 1 < high - low) { n *= 2; }
+		std::vector<std::vector<int>> old(n);
+		old.swap(bucket);
+		mask = n - 1;
+		occupied.assign((n + 63) / 64, 0);
+		filled.clear();
+		for (size_t b = 0; b < old.size(); b++) {
+			for (size_t i = 0; i < old[b].size(); i++) { place(old[b][i]); }
+		}
+	}
+
+	/*** next_filled() is how many buckets there are from b, round the circle, to the first one
+	not empty, of which there must be one. ***/
+	size_t next_filled(size_t b) const {
+		size_t words = occupied.size(), w = b >> 6;
+		uint64_t bits = occupied[w] & (~uint64_t(0) << (b & 63));
+		while (bits == 0) {
+			w = (w + 1 == words) ? 0 : w + 1;
+			bits = occupied[w];
+		}
+		return ((w << 6) + lowest_bit(bits) - b) & mask;
+	}
+
+	void place(int v) {
+		size_t at = (size_t)(keys[v] & mask);
+		std::vector<int>& b = bucket[at];
+		if (b.empty()) {
+			filled.push_back(at);
+			occupied[at >> 6] |= uint64_t(1) << (at & 63);
+		}
+		inside[v] = 1;
+		slot[v] = (int)b.size();
+		b.push_back(v);
+	}
+
+	void remove(int v) {
+		size_t at = (size_t)(keys[v] & mask);
+		std::vector<int>& from = bucket[at];
+		int moved = from.back();
+		from[slot[v]] = moved;
+		slot[moved] = slot[v];
+		from.pop_back();
+		if (from.empty()) occupied[at >> 6] &= ~(uint64_t(1) << (at & 63));
+		inside[v] = 0;
+	}
+};
+
+/*** integral_weights() tells whether every arc weight and vertex weight of g is a non-negative
+integer, and stores the largest in largest. ***/
+inline bool integral_weights(const csr_graph& g, double& largest) {
+	largest = 0;
+	for (size_t e = 0; e < g.weights.size(); e++) {
+		double w = g.weights[e];
+		if (!(w >= 0) || w != std::floor(w) || w > 9007199254740992.0) return false;
+		if (w > largest) largest = w;
+	}
+	for (size_t v = 0; v < g.node_weight.size(); v++) {
+		double w = g.node_weight[v];
+		if (!(w >= 0) || w != std::floor(w) || w > 9007199254740992.0) return false;
+		if (w > largest) largest = w;
+	}
+	return true;
+}
+
+/*** quantize_weights() returns g with every arc and vertex weight w replaced by the integer
+nearest to w * scale. Paths are then exact in units of 1 / scale. ***/
+inline csr_graph quantize_weights(const csr_graph& g, double scale) {
+	csr_storage s;
+	s.offsets.assign(g.offsets.begin(), g.offsets.end());
+	s.targets.assign(g.targets.begin(), g.targets.end());
+	s.weights.resize(g.weights.size());
+	for (size_t e = 0; e < g.weights.size(); e++) { s.weights[e] = std::round(g.weights[e] * scale); }
+	s.node_weight.resize(g.node_weight.size());
+	for (size_t v = 0; v < g.node_weight.size(); v++) { s.node_weight[v] = std::round(g.node_weight[v] * scale); }
+	s.name_start.assign(g.names.start.begin(), g.names.start.end());
+	s.name_chars.assign(g.names.chars.begin(), g.names.chars.end());
+	return csr_graph::adopt(std::move(s));
+}
+
+#endif
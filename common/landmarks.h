@@ -0,0 +1,177 @@
+/**********************************************************************************
+ * FILE:            landmarks.h
+ * DESCRIPTION:     Landmark bounds for A* search (the ALT method of Goldberg and
+ *                  Harrelson). A few landmark vertices are picked far apart, and
+ *                  the cost from every landmark to every vertex and back is
+ *                  stored. By the triangle inequality, the cost from v to t is
+ *                  at least cost(L, t) - cost(L, v) and cost(v, L) - cost(t, L)
+ *                  for every landmark L.
+ *                  Costs are the additive images of values (see cost() in
+ *                  semiring.h), with vertex weights charged to the arcs.
+ *                  The tables take 16 bytes per vertex and landmark, and can be
+ *                  saved next to the graph and loaded for later queries.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include "csr_graph.h"
+#include "dijkstra.h"
+#include "point_to_point.h"
+#include "snapshot.h"
+
+const char LANDMARKS_MAGIC[8] = { 'D', 'J', 'K', 'L', 'M', 'A', 'R', 'K' };
+const uint32_t LANDMARKS_VERSION = 1;
+
+struct landmarks_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t count;
+	uint64_t graph_id;		// graph_id() of the graph the tables were built for
+	int64_t num_vertices;
+};
+
+template <typename Semiring>
+class landmarks {
+public:
+	/*** landmarks(g, k) picks k landmarks and runs a search from and to each of them. The
+	first landmark is the vertex farthest from vertex 0, and every next one the vertex
+	farthest from those already picked. ***/
+	landmarks(const csr_graph& g, int k) : n(g.num_vertices()), id(graph_id(g)) {
+		if (n == 0) return;
+		csr_graph forward = fold_node_weights<Semiring>(g);
+		csr_graph backward = reverse_graph<Semiring>(g);
+		std::vector<double> nearest(n, std::numeric_limits<double>::infinity());
+		int next = farthest(costs(forward, 0));
+		for (int i = 0; i < k && next != -1; i++) {
+			ids.push_back(next);
+			from.push_back(costs(forward, next));
+			to.push_back(costs(backward, next));
+			for (int v = 0; v < n; v++) { if (from.back()[v] < nearest[v]) nearest[v] = from.back()[v]; }
+			next = farthest(nearest);
+			if (next != -1 && nearest[next] == 0) next = -1;
+		}
+	}
+
+	/*** landmarks(path, g) loads the tables saved by save(), throwing std::runtime_error
+	if they were built for another graph. ***/
+	landmarks(const std::string& path, const csr_graph& g) : n(g.num_vertices()), id(graph_id(g)) {
+		FILE* f = fopen(path.c_str(), "rb");
+		if (f == NULL) throw std::runtime_error("cannot open " + path);
+		landmarks_header h;
+		bool ok = fread(&h, sizeof(h), 1, f) == 1 && memcmp(h.magic, LANDMARKS_MAGIC, sizeof(h.magic)) == 0
+			&& h.version == LANDMARKS_VERSION;
+		if (ok && (h.graph_id != id || h.num_vertices != n)) {
+			fclose(f);
+			throw std::runtime_error(path + " was built for another graph");
+		}
+		if (ok) {
+			ids.resize(h.count);
+			from.assign(h.count, std::vector<double>(n));
+			to.assign(h.count, std::vector<double>(n));
+			ok = h.count == 0 || fread(ids.data(), sizeof(int), h.count, f) == h.count;
+			for (uint32_t i = 0; ok && i < h.count; i++) {
+				ok = fread(from[i].data(), sizeof(double), n, f) == (size_t)n && fread(to[i].data(), sizeof(double), n, f) == (size_t)n;
+			}
+		}
+		fclose(f);
+		if (!ok) throw std::runtime_error(path + " is not a landmarks file");
+	}
+
+	/*** save() writes the tables to path, throwing std::runtime_error on failure. ***/
+	void save(const std::string& path) const {
+		landmarks_header h;
+		memset(&h, 0, sizeof(h));
+		memcpy(h.magic, LANDMARKS_MAGIC, sizeof(h.magic));
+		h.version = LANDMARKS_VERSION;
+		h.count = (uint32_t)ids.size();
+		h.graph_id = id;
+		h.num_vertices = n;
+		FILE* f = fopen(path.c_str(), "wb");
+		if (f == NULL) throw std::runtime_error("cannot write " + path);
+		bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+		ok = ok && (ids.empty() || fwrite(ids.data(), sizeof(int), ids.size(), f) == ids.size());
+		for (size_t i = 0; ok && i < ids.size(); i++) {
+			ok = fwrite(from[i].data(), sizeof(double), n, f) == (size_t)n && fwrite(to[i].data(), sizeof(double), n, f) == (size_t)n;
+		}
+		if (fclose(f) != 0 || !ok) throw std::runtime_error("cannot write " + path);
+	}
+
+	int count() const { return (int)ids.size(); }
+	int landmark(int i) const { return ids[i]; }
+
+	/*** lower() is a lower bound of the cost from v to t. ***/
+	double lower(int v, int t) const {
+		double best = 0;
+		for (size_t i = 0; i < ids.size(); i++) {
+			// a bound involving an unreachable pair is either infinite and valid, or NaN and skipped
+			double a = from[i][t] - from[i][v];
+			double b = to[i][v] - to[i][t];
+			if (a > best) best = a;
+			if (b > best) best = b;
+		}
+		return best * (1 - 1e-9);	// the costs are rounded sums: stay on the safe side of them
+	}
+
+private:
+	int n;
+	uint64_t id;
+	std::vector<int> ids;
+	std::vector<std::vector<double>> from;	// from[i][v]: cost from landmark i to v
+	std::vector<std::vector<double>> to;		// to[i][v]: cost from v to landmark i
+
+	/*** costs() runs a full search from source and returns the cost of every vertex. ***/
+	std::vector<double> costs(const csr_graph& g, int source) const {
+		sssp_result S = dijkstra<Semiring>(g, source);
+		std::vector<double> c(n, std::numeric_limits<double>::infinity());
+		for (size_t i = 0; i < S.settled.size(); i++) { c[S.settled[i]] = Semiring::cost(S.value[S.settled[i]]); }
+		return c;
+	}
+
+	/*** farthest() returns the vertex of largest finite c, or -1 if there is none. ***/
+	int farthest(const std::vector<double>& c) const {
+		int best = -1;
+		for (int v = 0; v < n; v++) {
+			if (c[v] == std::numeric_limits<double>::infinity()) continue;
+			if (best == -1 || c[v] > c[best]) best = v;
+		}
+		return best;
+	}
+};
+
+/*** open_landmarks<S>() loads the tables saved at path, or picks k landmarks and saves them
+there if the file does not exist yet. An empty path is never read nor written. ***/
+template <typename Semiring>
+landmarks<Semiring> open_landmarks(const csr_graph& g, const std::string& path, int k) {
+	if (!path.empty()) {
+		FILE* f = fopen(path.c_str(), "rb");
+		if (f != NULL) {
+			fclose(f);
+			return landmarks<Semiring>(path, g);
+		}
+	}
+	landmarks<Semiring> L(g, k);
+	if (!path.empty()) L.save(path);
+	return L;
+}
+
+/*** landmark_bound<S> is the bound of astar() towards a fixed target. ***/
+template <typename Semiring>
+struct landmark_bound {
+	const landmarks<Semiring>& L;
+	int target;
+
+	landmark_bound(const landmarks<Semiring>& L, int target) : L(L), target(target) {}
+	double operator()(int v) const { return Semiring::from_cost(L.lower(v, target)); }
+};
+
+#endif
@@ -0,0 +1,313 @@
+/**********************************************************************************
+ * FILE:            loader.h
+ * DESCRIPTION:     Streaming loaders for edge lists and flights.csv. The file
+ *                  is memory-mapped and tokenized in place: fields are views
+ *                  into the mapping, so no std::string is allocated per field.
+ *                  Big files are cut at line boundaries into chunks that are
+ *                  parsed by several threads, and the graph arrays are built
+ *                  directly from the parsed chunks.
+ *
+ *                  Edge list format, one record per line, separated by blanks
+ *                  or commas; lines starting with # are comments:
+ *                      u v w      edge (or arc) between vertices u and v
+ *                      v p        weight p of vertex v, as p in exercise 26
+ *                  Vertices are numbered in order of first appearance.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <thread>
+#include <exception>
+#include <stdexcept>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include "arena.h"
+#include "mapped_file.h"
+#include "csr_graph.h"
+#include "timetable.h"
+
+typedef std::string_view field;
+
+/*** A chunk is the range [begin, end) of the mapping, made of whole lines. ***/
+struct chunk {
+	const char* begin;
+	const char* end;
+};
+
+/*** default_threads() uses one thread for files of less than 64 MB and every core above. ***/
+inline unsigned default_threads(size_t bytes) {
+	if (bytes < ((size_t)64 << 20)) return 1;
+	unsigned n = std::thread::hardware_concurrency();
+	return n == 0 ? 1 : n;
+}
+
+/*** split_chunks() cuts [begin, end) into at most k chunks that end right after a newline. ***/
+inline std::vector<chunk> split_chunks(const char* begin, const char* end, unsigned k) {
+	std::vector<chunk> chunks;
+	size_t size = end - begin;
+	const char* start = begin;
+	for (unsigned i = 1; i <= k && start < end; i++) {
+		const char* stop = (i == k) ? end : begin + size / k * i;
+		if (stop < start) stop = start;
+		while (stop < end && *stop != '\n') stop++;
+		if (stop < end) stop++;
+		chunks.push_back({ start, stop });
+		start = stop;
+	}
+	return chunks;
+}
+
+/*** parse_chunks() runs fn(chunk, result) on every chunk, each one on its own thread, and
+rethrows the first error found. ***/
+template <typename Result, typename Fn>
+std::vector<Result> parse_chunks(const std::vector<chunk>& chunks, Fn fn) {
+	std::vector<Result> results(chunks.size());
+	std::vector<std::exception_ptr> errors(chunks.size());
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < chunks.size(); i++) {
+		threads.emplace_back([&, i]() {
+			try { fn(chunks[i], results[i]); }
+			catch (...) { errors[i] = std::current_exception(); }
+		});
+	}
+	if (!chunks.empty()) {
+		try { fn(chunks[0], results[0]); }
+		catch (...) { errors[0] = std::current_exception(); }
+	}
+	for (size_t i = 0; i < threads.size(); i++) { threads[i].join(); }
+	for (size_t i = 0; i < errors.size(); i++) {
+		if (errors[i]) std::rethrow_exception(errors[i]);
+	}
+	return results;
+}
+
+/*** next_line() returns the line starting at p, without its line break, and moves p to the
+start of the next one. ***/
+inline field next_line(const char*& p, const char* end) {
+	const char* eol = (const char*)memchr(p, '\n', end - p);
+	if (eol == nullptr) eol = end;
+	const char* last = eol;
+	if (last > p && last[-1] == '\r') last--;
+	field line(p, last - p);
+	p = (eol < end) ? eol + 1 : end;
+	return line;
+}
+
+/*** split_fields() splits a CSV line at commas, dropping the quotes around a field, and
+returns the number of fields. Only the first max fields are stored. ***/
+inline int split_fields(field line, field* fields, int max) {
+	int n = 0;
+	size_t start = 0;
+	while (true) {
+		size_t comma = line.find(',', start);
+		field f = line.substr(start, (comma == field::npos) ? field::npos : comma - start);
+		if (f.size() >= 2 && f.front() == '"' && f.back() == '"') f = f.substr(1, f.size() - 2);
+		if (n < max) fields[n] = f;
+		n++;
+		if (comma == field::npos) return n;
+		start = comma + 1;
+	}
+}
+
+/*** split_words() splits a line at blanks and commas, and returns the number of words. ***/
+inline int split_words(field line, field* words, int max) {
+	int n = 0;
+	size_t i = 0;
+	while (i < line.size()) {
+		while (i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == ',')) i++;
+		if (i == line.size()) break;
+		size_t start = i;
+		while (i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != ',') i++;
+		if (n < max) words[n] = line.substr(start, i - start);
+		n++;
+	}
+	return n;
+}
+
+inline bool parse_int(field f, int64_t& value) {
+	std::from_chars_result r = std::from_chars(f.data(), f.data() + f.size(), value);
+	return r.ec == std::errc() && r.ptr == f.data() + f.size();
+}
+
+inline bool parse_double(field f, double& value) {
+	std::from_chars_result r = std::from_chars(f.data(), f.data() + f.size(), value);
+	return r.ec == std::errc() && r.ptr == f.data() + f.size();
+}
+
+/*** load_edge_list() reads an edge list into a csr_graph. Undirected edges are stored as two
+opposite arcs. Vertex weights are kept if the file sets any. threads = 0 picks a default. ***/
+inline csr_graph load_edge_list(const std::string& path, bool directed, unsigned threads = 0) {
+	mapped_file file;
+	if (!file.open(path)) throw std::runtime_error("cannot open " + path);
+	const char* begin = file.data();
+	const char* end = begin + file.size();
+	if (threads == 0) threads = default_threads(file.size());
+
+	// a record is an edge (a, b, w) or, if is_vertex is set, the weight w of vertex a
+	struct record {
+		field a, b;
+		double w;
+		bool is_vertex;
+	};
+	std::vector<std::vector<record>> parsed = parse_chunks<std::vector<record>>(split_chunks(begin, end, threads),
+		[](const chunk& c, std::vector<record>& out) {
+			const char* p = c.begin;
+			field words[3];
+			while (p < c.end) {
+				field line = next_line(p, c.end);
+				int n = split_words(line, words, 3);
+				if (n == 0 || words[0][0] == '#') continue;
+				record r = { words[0], field(), 0.0, n == 2 };
+				if (n == 3) r.b = words[1];
+				if ((n != 2 && n != 3) || !parse_double(words[n - 1], r.w)) {
+					throw std::runtime_error("malformed edge list line: " + std::string(line));
+				}
+				out.push_back(r);
+			}
+		});
+
+	// number the vertices in order of first appearance and count the arcs leaving each one;
+	// the nodes of the name index come from an arena, freed at once on return
+	typedef std::pair<const field, int> entry;
+	arena names;
+	std::unordered_map<field, int, std::hash<field>, std::equal_to<field>, arena_allocator<entry>> index(0, std::hash<field>(), std::equal_to<field>(), arena_allocator<entry>(names));
+	csr_storage g;
+	std::vector<int64_t> degree;
+	bool node_weights = false;
+	size_t m = 0;
+	auto vertex = [&](field name) {
+		auto ins = index.emplace(name, (int)degree.size());
+		if (ins.second) {
+			g.add_name(name);
+			degree.push_back(0);
+		}
+		return ins.first->second;
+	};
+	std::vector<std::vector<int>> ends(parsed.size());
+	for (size_t c = 0; c < parsed.size(); c++) {
+		ends[c].reserve(2 * parsed[c].size());
+		for (size_t i = 0; i < parsed[c].size(); i++) {
+			const record& r = parsed[c][i];
+			int u = vertex(r.a);
+			if (r.is_vertex) { node_weights = true; ends[c].push_back(u); continue; }
+			int v = vertex(r.b);
+			ends[c].push_back(u);
+			ends[c].push_back(v);
+			degree[u]++;
+			if (!directed) degree[v]++;
+			m += directed ? 1 : 2;
+		}
+	}
+
+	// lay out the arcs, keeping the order of the file within every vertex
+	int n = (int)degree.size();
+	g.offsets.assign(n + 1, 0);
+	for (int u = 0; u < n; u++) { g.offsets[u + 1] = g.offsets[u] + degree[u]; }
+	g.targets.resize(m);
+	g.weights.resize(m);
+	if (node_weights) g.node_weight.assign(n, 0.0);
+	std::vector<int64_t> next(g.offsets.begin(), g.offsets.end() - 1);
+	for (size_t c = 0; c < parsed.size(); c++) {
+		size_t k = 0;
+		for (size_t i = 0; i < parsed[c].size(); i++) {
+			const record& r = parsed[c][i];
+			if (r.is_vertex) { g.node_weight[ends[c][k++]] = r.w; continue; }
+			int u = ends[c][k++];
+			int v = ends[c][k++];
+			int64_t e = next[u]++;
+			g.targets[e] = v;
+			g.weights[e] = r.w;
+			if (!directed) {
+				e = next[v]++;
+				g.targets[e] = u;
+				g.weights[e] = r.w;
+			}
+		}
+	}
+	return csr_graph::adopt(std::move(g));
+}
+
+/*** load_flights() reads flights.csv into a timetable, with the columns origin, dest, year,
+month, day, dep_time and arr_time. As dropna() in exercise 12, rows with an empty or NA field
+are skipped, and flights that arrive before they depart land on the next day. The id of a
+connection is its row among the data rows of the file. ***/
+inline void load_flights(const std::string& path, timetable& T, unsigned threads = 0) {
+	mapped_file file;
+	if (!file.open(path)) throw std::runtime_error("cannot open " + path);
+	const char* p = file.data();
+	const char* end = p + file.size();
+	if (threads == 0) threads = default_threads(file.size());
+
+	enum { ORIGIN, DEST, YEAR, MONTH, DAY, DEP, ARR, NCOLS };
+	const char* names[NCOLS] = { "origin", "dest", "year", "month", "day", "dep_time", "arr_time" };
+	int col[NCOLS];
+	field header_line = next_line(p, end);
+	int ncols = split_fields(header_line, nullptr, 0);
+	std::vector<field> header(ncols);
+	split_fields(header_line, header.data(), ncols);
+	for (int k = 0; k < NCOLS; k++) {
+		col[k] = -1;
+		for (int i = 0; i < ncols; i++) { if (header[i] == names[k]) col[k] = i; }
+		if (col[k] == -1) throw std::runtime_error(path + " has no column " + names[k]);
+	}
+
+	struct flight {
+		field origin, dest;
+		int64_t dep, arr, row;
+	};
+	struct part {
+		std::vector<flight> flights;
+		int64_t rows = 0;
+	};
+	std::vector<part> parsed = parse_chunks<part>(split_chunks(p, end, threads),
+		[&](const chunk& c, part& out) {
+			std::vector<field> f(ncols);
+			const char* q = c.begin;
+			while (q < c.end) {
+				field line = next_line(q, c.end);
+				if (line.empty()) continue;
+				int64_t row = out.rows++;
+				if (split_fields(line, f.data(), ncols) != ncols) continue;
+				bool missing = false;
+				for (int i = 0; i < ncols && !missing; i++) { missing = f[i].empty() || f[i] == "NA"; }
+				if (missing) continue;
+				int64_t v[NCOLS];
+				for (int k = YEAR; k < NCOLS; k++) {
+					if (!parse_int(f[col[k]], v[k])) throw std::runtime_error("malformed number in line: " + std::string(line));
+				}
+				int64_t dep = minutes_from_civil((int)v[YEAR], (int)v[MONTH], (int)v[DAY], (int)v[DEP]);
+				int64_t arr = minutes_from_civil((int)v[YEAR], (int)v[MONTH], (int)v[DAY], (int)v[ARR]);
+				if (arr < dep) arr += 1440;
+				out.flights.push_back({ f[col[ORIGIN]], f[col[DEST]], dep, arr, row });
+			}
+		});
+
+	// rows are numbered within their chunk: shift them by the rows of the chunks before
+	std::unordered_map<field, int> index;
+	auto stop = [&](field code) {
+		std::unordered_map<field, int>::iterator it = index.find(code);
+		if (it != index.end()) return it->second;
+		int s = T.stop(std::string(code));
+		index.emplace(code, s);
+		return s;
+	};
+	int64_t first_row = 0;
+	for (size_t c = 0; c < parsed.size(); c++) {
+		for (size_t i = 0; i < parsed[c].flights.size(); i++) {
+			const flight& fl = parsed[c].flights[i];
+			T.add_connection(stop(fl.origin), stop(fl.dest), fl.dep, fl.arr, first_row + fl.row);
+		}
+		first_row += parsed[c].rows;
+	}
+	T.finalize();
+}
+
+#endif
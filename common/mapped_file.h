@@ -0,0 +1,100 @@
+/**********************************************************************************
+ * FILE:            mapped_file.h
+ * DESCRIPTION:     Read-only memory mapping of a whole file. The pages are
+ *                  loaded lazily by the operating system and shared with any
+ *                  other process that maps the same file.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// external_seek() is fseek() with a 64-bit offset, which long is not on Windows
+#ifdef _WIN32
+#define external_seek _fseeki64
+#else
+#define external_seek fseeko
+#endif
+
+class mapped_file {
+public:
+	mapped_file() {}
+	explicit mapped_file(const std::string& path) { open(path); }
+	~mapped_file() { close(); }
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+
+	/*** open() maps the file and returns false if it cannot be read. An empty file maps
+	to a null pointer of size 0. ***/
+	bool open(const std::string& path) {
+		close();
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE) return false;
+		LARGE_INTEGER len;
+		if (!GetFileSizeEx(file, &len)) { CloseHandle(file); return false; }
+		len_ = (size_t)len.QuadPart;
+		if (len_ > 0) {
+			HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+			if (mapping != NULL) {
+				data_ = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+				CloseHandle(mapping);
+			}
+		}
+		CloseHandle(file);
+#else
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd == -1) return false;
+		struct stat st;
+		if (fstat(fd, &st) == -1) { ::close(fd); return false; }
+		len_ = (size_t)st.st_size;
+		if (len_ > 0) {
+			void* p = mmap(NULL, len_, PROT_READ, MAP_SHARED, fd, 0);
+			if (p != MAP_FAILED) {
+				data_ = (const char*)p;
+				madvise(p, len_, MADV_SEQUENTIAL);
+			}
+		}
+		::close(fd);
+#endif
+		if (len_ > 0 && data_ == nullptr) { len_ = 0; return false; }
+		is_open_ = true;
+		return true;
+	}
+
+	void close() {
+		if (data_ != nullptr) {
+#ifdef _WIN32
+			UnmapViewOfFile(data_);
+#else
+			munmap((void*)data_, len_);
+#endif
+		}
+		data_ = nullptr;
+		len_ = 0;
+		is_open_ = false;
+	}
+
+	bool is_open() const { return is_open_; }
+	const char* data() const { return data_; }
+	size_t size() const { return len_; }
+
+private:
+	const char* data_ = nullptr;
+	size_t len_ = 0;
+	bool is_open_ = false;
+};
+
+#endif
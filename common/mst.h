@@ -0,0 +1,102 @@
+/**********************************************************************************
+ * FILE:            mst.h
+ * DESCRIPTION:     Edge lists and the sequential Kruskal and Prim algorithms,
+ *                  shared by the minimum spanning tree programs and the
+ *                  benchmark to cross-check results.
+ *                  An edge is the pair (weight, (u, v)) used by kruskal.cpp
+ *                  and prim.cpp, here with u and v in 0..V-1.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef MST_H
+#define MST_H
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <queue>
+#include <functional>
+#include "disjoint_set.h"
+#include "csr_graph.h"
+#include "indexed_heap.h"
+
+typedef std::pair<float, std::pair<int, int>> mst_edge;
+
+/*** kruskal_mst() returns the edges of a minimum spanning forest by ascending weight. ***/
+inline std::vector<mst_edge> kruskal_mst(int V, std::vector<mst_edge> edges) {
+	std::sort(edges.begin(), edges.end());
+	disjoint_set sets(V);
+	std::vector<mst_edge> F;
+	for (size_t i = 0; i < edges.size() && (int)F.size() < V - 1; i++) {
+		if (sets.unite(edges[i].second.first, edges[i].second.second)) F.push_back(edges[i]);
+	}
+	return F;
+}
+
+/*** prim_mst() returns the edges of a minimum spanning forest of an undirected graph, grown
+from vertex 0 and then from every vertex not reached yet, with an indexed heap keyed by
+the lightest edge of every vertex to the tree. Any queue with the interface of indexed_heap
+will do, such as bucket_queue of integer_queues.h on integer weights. ***/
+template <typename Queue = indexed_heap<float>>
+std::vector<mst_edge> prim_mst(const csr_graph& g) {
+	typedef typename Queue::key_type key_type;
+	int V = g.num_vertices();
+	Queue P(V);
+	std::vector<int> parent(V, -1);
+	std::vector<char> in_tree(V, 0);
+	std::vector<mst_edge> F;
+	for (int s = 0; s < V; s++) {
+		if (in_tree[s]) continue;
+		P.push(s, key_type(0));
+		while (!P.empty()) {
+			int u = P.pop();
+			in_tree[u] = 1;
+			if (parent[u] != -1) F.push_back(mst_edge((float)P.key(u), std::make_pair(parent[u], u)));
+			for (int64_t e = g.begin(u); e < g.end(u); e++) {
+				int v = g.targets[e];
+				key_type we = (key_type)g.weights[e];
+				if (in_tree[v] || (P.contains(v) && P.key(v) <= we)) continue;
+				parent[v] = u;
+				P.update(v, we);
+			}
+		}
+	}
+	return F;
+}
+
+/*** prim_lazy_mst() is prim_mst() with a binary heap of candidate edges, the ones whose
+endpoint has joined the tree being discarded when they reach the top. ***/
+inline std::vector<mst_edge> prim_lazy_mst(const csr_graph& g) {
+	int V = g.num_vertices();
+	std::priority_queue<mst_edge, std::vector<mst_edge>, std::greater<mst_edge>> P;	// weight, (tree, outside)
+	std::vector<char> in_tree(V, 0);
+	std::vector<mst_edge> F;
+	for (int s = 0; s < V; s++) {
+		if (in_tree[s]) continue;
+		P.push(mst_edge(0.f, std::make_pair(-1, s)));
+		while (!P.empty()) {
+			mst_edge best = P.top();
+			P.pop();
+			int u = best.second.second;
+			if (in_tree[u]) continue;
+			in_tree[u] = 1;
+			if (best.second.first != -1) F.push_back(best);
+			for (int64_t e = g.begin(u); e < g.end(u); e++) {
+				int v = g.targets[e];
+				if (!in_tree[v]) P.push(mst_edge((float)g.weights[e], std::make_pair(u, v)));
+			}
+		}
+	}
+	return F;
+}
+
+/*** tree_cost() computes the cost of a spanning tree. Sum the edges in ascending order of
+weight (as Kruskal selects them) to get the same float for the same tree. ***/
+inline float tree_cost(const std::vector<mst_edge>& edges) {
+	float cost = 0.f;
+	for (size_t i = 0; i < edges.size(); i++) { cost += edges[i].first; }
+	return cost;
+}
+
+#endif
@@ -0,0 +1,106 @@
+/**********************************************************************************
+ * FILE:            parallel.h
+ * DESCRIPTION:     Minimal fork-join helpers on top of std::thread.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstddef>
+
+/*** hardware_threads() is the number of cores, or 1 if it cannot be known. ***/
+inline unsigned hardware_threads() {
+	unsigned n = std::thread::hardware_concurrency();
+	return n == 0 ? 1 : n;
+}
+
+/*** parallel_for() splits [0, n) into one contiguous block per thread and runs
+fn(begin, end, thread) on each of them. The calling thread takes block 0. ***/
+template <typename Fn>
+void parallel_for(size_t n, unsigned threads, Fn fn) {
+	if (threads <= 1 || n < 2 * (size_t)threads) {
+		fn((size_t)0, n, 0u);
+		return;
+	}
+	std::vector<std::thread> pool;
+	for (unsigned t = 1; t < threads; t++) {
+		pool.emplace_back([=, &fn]() { fn(n * t / threads, n * (t + 1) / threads, t); });
+	}
+	fn((size_t)0, n / threads, 0u);
+	for (size_t t = 0; t < pool.size(); t++) { pool[t].join(); }
+}
+
+/*** thread_team keeps threads - 1 workers alive between parallel steps, for algorithms that
+run many short steps in a row. run(fn) calls fn(thread) on every member, the caller being
+thread 0, and returns when all of them are done. ***/
+class thread_team {
+public:
+	explicit thread_team(unsigned threads) : size_(threads == 0 ? hardware_threads() : threads) {
+		for (unsigned t = 1; t < size_; t++) { workers.emplace_back([this, t]() { work(t); }); }
+	}
+
+	~thread_team() {
+		{
+			std::lock_guard<std::mutex> lock(m);
+			quit = true;
+			generation++;
+		}
+		start.notify_all();
+		for (size_t t = 0; t < workers.size(); t++) { workers[t].join(); }
+	}
+
+	thread_team(const thread_team&) = delete;
+	thread_team& operator=(const thread_team&) = delete;
+
+	unsigned size() const { return size_; }
+
+	void run(const std::function<void(unsigned)>& fn) {
+		if (size_ == 1) { fn(0); return; }
+		{
+			std::lock_guard<std::mutex> lock(m);
+			job = &fn;
+			pending = size_ - 1;
+			generation++;
+		}
+		start.notify_all();
+		fn(0);
+		std::unique_lock<std::mutex> lock(m);
+		done.wait(lock, [this]() { return pending == 0; });
+	}
+
+private:
+	unsigned size_;
+	std::vector<std::thread> workers;
+	std::mutex m;
+	std::condition_variable start, done;
+	const std::function<void(unsigned)>* job = nullptr;
+	unsigned pending = 0;
+	unsigned long long generation = 0;
+	bool quit = false;
+
+	void work(unsigned t) {
+		unsigned long long seen = 0;
+		while (true) {
+			const std::function<void(unsigned)>* fn;
+			{
+				std::unique_lock<std::mutex> lock(m);
+				start.wait(lock, [&]() { return generation != seen; });
+				seen = generation;
+				if (quit) return;
+				fn = job;
+			}
+			(*fn)(t);
+			std::lock_guard<std::mutex> lock(m);
+			if (--pending == 0) done.notify_one();
+		}
+	}
+};
+
+#endif
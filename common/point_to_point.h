@@ -0,0 +1,225 @@
+/**********************************************************************************
+ * FILE:            point_to_point.h
+ * DESCRIPTION:     Searches for a single source and target, which can stop much
+ *                  earlier than a plain Dijkstra search growing from the source:
+ *                      bidirectional_search   grows one search from the source
+ *                                             and one backwards from the target,
+ *                                             and stops when they meet
+ *                      astar                  Dijkstra's algorithm guided by an
+ *                                             optimistic bound of the value still
+ *                                             to come (see landmarks.h)
+ *                  Both return the path itself and its value, folded from the
+ *                  source in the same order as dijkstra.h, so the value of a
+ *                  path does not depend on the search that found it.
+ *                  The semirings must be commutative, as all of semiring.h are.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef POINT_TO_POINT_H
+#define POINT_TO_POINT_H
+
+#include <vector>
+#include <algorithm>
+#include "csr_graph.h"
+#include "indexed_heap.h"
+#include "semiring.h"
+
+/*** Result of a point-to-point search: the vertices of the path from source to target,
+its value, and how many vertices the search settled to find it. ***/
+struct path_result {
+	std::vector<int> path;
+	double value = 0;
+	size_t settled = 0;
+	bool reached = false;
+};
+
+/*** fold_node_weights<S>() returns the graph with the weight of the head of every arc
+charged to the arc, as dijkstra.h charges it when the path enters the vertex. ***/
+template <typename Semiring>
+csr_graph fold_node_weights(const csr_graph& g) {
+	if (!g.has_node_weights()) return g;
+	csr_storage s;
+	s.offsets.assign(g.offsets.begin(), g.offsets.end());
+	s.targets.assign(g.targets.begin(), g.targets.end());
+	s.weights.resize(g.num_arcs());
+	for (int64_t e = 0; e < g.num_arcs(); e++) { s.weights[e] = Semiring::extend(g.weights[e], g.node_weight[g.targets[e]]); }
+	s.name_start.assign(g.names.start.begin(), g.names.start.end());
+	s.name_chars.assign(g.names.chars.begin(), g.names.chars.end());
+	return csr_graph::adopt(std::move(s));
+}
+
+/*** reverse_graph<S>() returns the graph with every arc turned around, vertex weights
+folded into the arcs first. The names are not copied. ***/
+template <typename Semiring>
+csr_graph reverse_graph(const csr_graph& g) {
+	int n = g.num_vertices();
+	int64_t m = g.num_arcs();
+	csr_storage s;
+	s.offsets.assign(n + 1, 0);
+	for (int64_t e = 0; e < m; e++) { s.offsets[g.targets[e] + 1]++; }
+	for (int v = 0; v < n; v++) { s.offsets[v + 1] += s.offsets[v]; }
+	s.targets.resize(m);
+	s.weights.resize(m);
+	std::vector<int64_t> next(s.offsets.begin(), s.offsets.end() - 1);
+	for (int u = 0; u < n; u++) {
+		for (int64_t e = g.begin(u); e < g.end(u); e++) {
+			int v = g.targets[e];
+			double w = g.weights[e];
+			if (g.has_node_weights()) w = Semiring::extend(w, g.node_weight[v]);
+			int64_t slot = next[v]++;
+			s.targets[slot] = u;
+			s.weights[slot] = w;
+		}
+	}
+	return csr_graph::adopt(std::move(s));
+}
+
+/*** path_value<S>() folds the value of a path from its source, as dijkstra.h does. ***/
+template <typename Semiring>
+double path_value(const csr_graph& g, const std::vector<int>& path) {
+	if (path.empty()) return Semiring::zero();
+	double value = Semiring::one();
+	if (g.has_node_weights()) value = Semiring::extend(value, g.node_weight[path[0]]);
+	for (size_t i = 1; i < path.size(); i++) {
+		int u = path[i - 1], v = path[i];
+		double best = Semiring::zero();
+		for (int64_t e = g.begin(u); e < g.end(u); e++) {
+			if (g.targets[e] != v) continue;
+			double w = g.weights[e];
+			if (g.has_node_weights()) w = Semiring::extend(w, g.node_weight[v]);
+			double cand = Semiring::extend(value, w);
+			if (Semiring::better(cand, best)) best = cand;
+		}
+		value = best;
+	}
+	return value;
+}
+
+/*** trace_path() follows pred back from v and returns the path that ends at v. ***/
+inline std::vector<int> trace_path(const std::vector<int>& pred, int v) {
+	std::vector<int> path;
+	for (; v != -1; v = pred[v]) { path.push_back(v); }
+	std::reverse(path.begin(), path.end());
+	return path;
+}
+
+/*** bidirectional_search<S> keeps the reverse graph, so it can answer many queries on the
+same graph. The two searches take turns by the size of their queues, and stop when the
+best path seen through a vertex labelled by both cannot be beaten by extending the tops
+of the two queues. ***/
+template <typename Semiring>
+class bidirectional_search {
+public:
+	explicit bidirectional_search(const csr_graph& g) : g(g), r(reverse_graph<Semiring>(g)) {}
+
+	path_result run(int source, int target) {
+		int n = g.num_vertices();
+		std::vector<double> df(n, Semiring::zero()), db(n, Semiring::zero());
+		std::vector<int> pf(n, -1), pb(n, -1);
+		std::vector<char> done_f(n, 0), done_b(n, 0);
+		indexed_heap<double, semiring_order<Semiring>> F(n), B(n);
+		path_result res;
+
+		df[source] = Semiring::one();
+		if (g.has_node_weights()) df[source] = Semiring::extend(df[source], g.node_weight[source]);
+		db[target] = Semiring::one();
+		F.push(source, df[source]);
+		B.push(target, db[target]);
+		double best = Semiring::zero();
+		int meet = -1;
+		if (source == target) { best = df[source]; meet = source; }
+
+		while (!F.empty() && !B.empty()) {
+			if (!Semiring::better(Semiring::extend(F.top_key(), B.top_key()), best)) break;
+			bool forward = F.size() <= B.size();
+			const csr_graph& h = forward ? g : r;
+			indexed_heap<double, semiring_order<Semiring>>& Q = forward ? F : B;
+			std::vector<double>& d = forward ? df : db;
+			std::vector<double>& other = forward ? db : df;
+			std::vector<int>& pred = forward ? pf : pb;
+			std::vector<char>& done = forward ? done_f : done_b;
+
+			int u = Q.pop();
+			done[u] = 1;
+			res.settled++;
+			double du = d[u];
+			for (int64_t e = h.begin(u); e < h.end(u); e++) {
+				int v = h.targets[e];
+				if (done[v]) continue;
+				double w = h.weights[e];
+				if (forward && h.has_node_weights()) w = Semiring::extend(w, h.node_weight[v]);
+				double cand = Semiring::extend(du, w);
+				if (Semiring::better(cand, d[v])) {
+					d[v] = cand;
+					pred[v] = u;
+					Q.update(v, cand);
+				}
+				double through = Semiring::extend(d[v], other[v]);
+				if (Semiring::better(through, best)) { best = through; meet = v; }
+			}
+		}
+
+		if (meet == -1) return res;
+		res.path = trace_path(pf, meet);
+		for (int v = pb[meet]; v != -1; v = pb[v]) { res.path.push_back(v); }
+		res.value = path_value<Semiring>(g, res.path);
+		res.reached = true;
+		return res;
+	}
+
+private:
+	const csr_graph& g;
+	csr_graph r;
+};
+
+/*** no_bound<S> is the bound of plain Dijkstra: every vertex may still lead to the target
+at no further cost. ***/
+template <typename Semiring>
+struct no_bound {
+	double operator()(int) const { return Semiring::one(); }
+};
+
+/*** astar<S>() runs Dijkstra's algorithm ordered by extend(value[v], bound(v)) and stops
+when target is settled. bound(v) must never be worse than the best value of a path from
+v to target, as no_bound and landmark_bound are. A vertex whose value still improves
+after it was settled is queued again, so rounding in the bound costs time, not
+correctness. ***/
+template <typename Semiring, typename Bound>
+path_result astar(const csr_graph& g, int source, int target, const Bound& bound) {
+	int n = g.num_vertices();
+	std::vector<double> value(n, Semiring::zero());
+	std::vector<int> pred(n, -1);
+	indexed_heap<double, semiring_order<Semiring>> Q(n);
+	path_result res;
+
+	value[source] = Semiring::one();
+	if (g.has_node_weights()) value[source] = Semiring::extend(value[source], g.node_weight[source]);
+	Q.push(source, Semiring::extend(value[source], bound(source)));
+
+	while (!Q.empty()) {
+		int u = Q.pop();
+		res.settled++;
+		if (u == target) {
+			res.path = trace_path(pred, target);
+			res.value = value[target];
+			res.reached = true;
+			break;
+		}
+		double du = value[u];
+		for (int64_t e = g.begin(u); e < g.end(u); e++) {
+			int v = g.targets[e];
+			double w = g.weights[e];
+			if (g.has_node_weights()) w = Semiring::extend(w, g.node_weight[v]);
+			double cand = Semiring::extend(du, w);
+			if (Semiring::better(cand, value[v])) {
+				value[v] = cand;
+				pred[v] = u;
+				Q.update(v, Semiring::extend(cand, bound(v)));
+			}
+		}
+	}
+	return res;
+}
+
+#endif
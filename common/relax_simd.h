@@ -0,0 +1,130 @@
+/**********************************************************************************
+ * FILE:            relax_simd.h
+ * DESCRIPTION:     Relaxation of all the arcs of a vertex at once, for graphs
+ *                  whose vertex weights have been folded into their arcs
+ *                  (fold_node_weights() in point_to_point.h), so that every
+ *                  arc has a single effective weight. relax_run() computes the
+ *                  candidate value through every arc, gathers the current
+ *                  values of their heads, and returns the arcs that improve
+ *                  them; the caller applies those in order, as the plain loop
+ *                  would. On processors with AVX2 four arcs are done per
+ *                  instruction, chosen when the program runs; elsewhere the
+ *                  same work is done one arc at a time. Both give the same
+ *                  values, bit for bit, as the loop of dijkstra.h.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef RELAX_SIMD_H
+#define RELAX_SIMD_H
+
+#include <cstdint>
+#include <cstddef>
+#include "semiring.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RELAX_SIMD_X86
+#include <immintrin.h>
+#endif
+
+/*** The vertex arrays a relaxation reads, stamped as in sssp_workspace: value[v] only counts
+if mark[v] >= seen, and v is settled if mark[v] == seen + 1. Marks are below 2^31,
+which the AVX2 path relies on: it compares them as signed 32-bit integers. ***/
+struct relax_state {
+	const double* value;
+	const uint32_t* mark;
+	uint32_t seen;
+};
+
+/*** relax_run_scalar() writes to hits the positions i < n of the arcs whose candidate, stored
+in cand[i], is better than the current value of their head, which is not settled. It
+returns how many there are. ***/
+template <typename Semiring>
+size_t relax_run_scalar(double du, const double* w, const int* targets, size_t n, const relax_state& s, int* hits, double* cand) {
+	size_t found = 0;
+	for (size_t i = 0; i < n; i++) {
+		int v = targets[i];
+		if (s.mark[v] == s.seen + 1) continue;
+		double c = Semiring::extend(du, w[i]);
+		if (Semiring::better(c, s.mark[v] >= s.seen ? s.value[v] : Semiring::zero())) {
+			cand[i] = c;
+			hits[found++] = (int)i;
+		}
+	}
+	return found;
+}
+
+#ifdef RELAX_SIMD_X86
+/*** simd_lanes<S> is extend() and better() of semiring S on four values at a time, with the
+operations in the same order as in semiring.h. ***/
+template <typename Semiring>
+struct simd_lanes;
+
+template <>
+struct simd_lanes<max_product> {
+	__attribute__((target("avx2"))) static __m256d extend(__m256d a, __m256d w) { return _mm256_mul_pd(a, w); }
+	__attribute__((target("avx2"))) static __m256d better(__m256d a, __m256d b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+};
+
+template <>
+struct simd_lanes<noisy_or> {
+	__attribute__((target("avx2"))) static __m256d extend(__m256d a, __m256d w) { return _mm256_sub_pd(_mm256_add_pd(a, w), _mm256_mul_pd(a, w)); }
+	__attribute__((target("avx2"))) static __m256d better(__m256d a, __m256d b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+};
+
+template <>
+struct simd_lanes<min_sum> {
+	__attribute__((target("avx2"))) static __m256d extend(__m256d a, __m256d w) { return _mm256_add_pd(a, w); }
+	__attribute__((target("avx2"))) static __m256d better(__m256d a, __m256d b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+};
+
+template <>
+struct simd_lanes<bottleneck> {
+	__attribute__((target("avx2"))) static __m256d extend(__m256d a, __m256d w) { return _mm256_min_pd(w, a); }
+	__attribute__((target("avx2"))) static __m256d better(__m256d a, __m256d b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+};
+
+/*** relax_run_avx2() is relax_run_scalar() four arcs at a time, the marks and values of the
+heads being gathered from memory. ***/
+template <typename Semiring>
+__attribute__((target("avx2")))
+size_t relax_run_avx2(double du, const double* w, const int* targets, size_t n, const relax_state& s, int* hits, double* cand) {
+	typedef simd_lanes<Semiring> L;
+	const __m256d a = _mm256_set1_pd(du);
+	const __m256d zero = _mm256_set1_pd(Semiring::zero());
+	const __m128i before = _mm_set1_epi32((int)s.seen - 1);
+	const __m128i settled = _mm_set1_epi32((int)s.seen + 1);
+	size_t found = 0, i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(targets + i));
+		__m256d c = L::extend(a, _mm256_loadu_pd(w + i));
+		__m128i mark = _mm_i32gather_epi32((const int*)s.mark, v, 4);
+		__m128i seen = _mm_cmpgt_epi32(mark, before);
+		__m128i done = _mm_cmpeq_epi32(mark, settled);
+		// values are only gathered for the heads reached in this search, the others are zero()
+		__m256d current = _mm256_mask_i32gather_pd(zero, s.value, v, _mm256_castsi256_pd(_mm256_cvtepi32_epi64(seen)), 8);
+		__m256d open = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_xor_si128(done, _mm_set1_epi32(-1))));
+		int mask = _mm256_movemask_pd(_mm256_and_pd(L::better(c, current), open));
+		if (mask == 0) continue;
+		_mm256_storeu_pd(cand + i, c);
+		for (int lane = 0; lane < 4; lane++) {
+			if (mask & (1 << lane)) hits[found++] = (int)(i + lane);
+		}
+	}
+	size_t rest = relax_run_scalar<Semiring>(du, w + i, targets + i, n - i, s, hits + found, cand + i);
+	for (size_t k = found; k < found + rest; k++) { hits[k] += (int)i; }
+	return found + rest;
+}
+#endif
+
+/*** relax_run() calls the widest version the processor can run, on vertices of degree large
+enough to fill a few vectors. ***/
+template <typename Semiring>
+size_t relax_run(double du, const double* w, const int* targets, size_t n, const relax_state& s, int* hits, double* cand) {
+#ifdef RELAX_SIMD_X86
+	static const bool avx2 = __builtin_cpu_supports("avx2");
+	if (avx2 && n >= 8) return relax_run_avx2<Semiring>(du, w, targets, n, s, hits, cand);
+#endif
+	return relax_run_scalar<Semiring>(du, w, targets, n, s, hits, cand);
+}
+
+#endif
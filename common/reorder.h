@@ -0,0 +1,134 @@
+/**********************************************************************************
+ * FILE:            reorder.h
+ * DESCRIPTION:     Renumbering of the vertices of a graph so that vertices
+ *                  reached close together in a search are also close together
+ *                  in memory, and their values, marks and arcs share cache
+ *                  lines. Vertex ids otherwise follow the order in which the
+ *                  names first appear in the input, which is usually arbitrary.
+ *                      bfs      order of a breadth-first search, one component
+ *                               after another
+ *                      rcm      reverse Cuthill-McKee: breadth-first from a
+ *                               vertex of least degree, neighbours by ascending
+ *                               degree, the whole order reversed
+ *                      degree   hubs first, by descending degree
+ *                  The permutation is kept both ways, and the names and vertex
+ *                  weights move with their vertices, so results printed by name
+ *                  need no translation.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef REORDER_H
+#define REORDER_H
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include "csr_graph.h"
+
+enum class vertex_order { none, bfs, rcm, degree };
+
+inline const char* order_name(vertex_order o) {
+	switch (o) {
+	case vertex_order::bfs: return "bfs";
+	case vertex_order::rcm: return "rcm";
+	case vertex_order::degree: return "degree";
+	default: return "none";
+	}
+}
+
+/*** parse_order() reads none, bfs, rcm or degree. ***/
+inline vertex_order parse_order(const std::string& name) {
+	if (name == "none") return vertex_order::none;
+	if (name == "bfs") return vertex_order::bfs;
+	if (name == "rcm") return vertex_order::rcm;
+	if (name == "degree") return vertex_order::degree;
+	throw std::runtime_error("unknown vertex order " + name);
+}
+
+/*** A renumbering of the vertices: vertex v becomes new_id[v], and new vertex i was old_id[i]. ***/
+struct vertex_permutation {
+	std::vector<int> old_id;
+	std::vector<int> new_id;
+};
+
+/*** order_vertices() returns the permutation of the vertices of g for the given order. ***/
+inline vertex_permutation order_vertices(const csr_graph& g, vertex_order order) {
+	int n = g.num_vertices();
+	vertex_permutation P;
+	P.old_id.reserve(n);
+	if (order == vertex_order::none) {
+		for (int v = 0; v < n; v++) { P.old_id.push_back(v); }
+	}
+	else if (order == vertex_order::degree) {
+		for (int v = 0; v < n; v++) { P.old_id.push_back(v); }
+		std::stable_sort(P.old_id.begin(), P.old_id.end(), [&](int a, int b) { return g.degree(a) > g.degree(b); });
+	}
+	else {
+		// breadth-first, every new component from the next unreached vertex of starts
+		bool rcm = (order == vertex_order::rcm);
+		std::vector<int> starts(n);
+		for (int v = 0; v < n; v++) { starts[v] = v; }
+		if (rcm) std::stable_sort(starts.begin(), starts.end(), [&](int a, int b) { return g.degree(a) < g.degree(b); });
+		std::vector<char> reached(n, 0);
+		std::vector<int> next;
+		for (int i = 0; i < n; i++) {
+			if (reached[starts[i]]) continue;
+			reached[starts[i]] = 1;
+			size_t head = P.old_id.size();
+			P.old_id.push_back(starts[i]);
+			for (; head < P.old_id.size(); head++) {
+				int u = P.old_id[head];
+				next.clear();
+				for (int64_t e = g.begin(u); e < g.end(u); e++) {
+					int v = g.targets[e];
+					if (!reached[v]) { reached[v] = 1; next.push_back(v); }
+				}
+				if (rcm) std::stable_sort(next.begin(), next.end(), [&](int a, int b) { return g.degree(a) < g.degree(b); });
+				P.old_id.insert(P.old_id.end(), next.begin(), next.end());
+			}
+		}
+		if (rcm) std::reverse(P.old_id.begin(), P.old_id.end());
+	}
+	P.new_id.assign(n, 0);
+	for (int i = 0; i < n; i++) { P.new_id[P.old_id[i]] = i; }
+	return P;
+}
+
+/*** permute() returns g with its vertices renumbered by P. The arcs of every vertex are sorted
+by head, so that a vertex reads the values of its neighbours in the order they lie in memory. ***/
+inline csr_graph permute(const csr_graph& g, const vertex_permutation& P) {
+	int n = g.num_vertices();
+	csr_storage s;
+	s.offsets.assign(n + 1, 0);
+	s.targets.resize(g.num_arcs());
+	s.weights.resize(g.num_arcs());
+	if (g.has_node_weights()) s.node_weight.resize(n);
+	std::vector<std::pair<int, double>> run;
+	for (int i = 0; i < n; i++) {
+		int u = P.old_id[i];
+		run.clear();
+		for (int64_t e = g.begin(u); e < g.end(u); e++) { run.push_back(std::make_pair(P.new_id[g.targets[e]], g.weights[e])); }
+		std::stable_sort(run.begin(), run.end(), [](const std::pair<int, double>& a, const std::pair<int, double>& b) { return a.first < b.first; });
+		int64_t first = s.offsets[i];
+		for (size_t k = 0; k < run.size(); k++) {
+			s.targets[first + k] = run[k].first;
+			s.weights[first + k] = run[k].second;
+		}
+		s.offsets[i + 1] = first + (int64_t)run.size();
+		if (g.has_node_weights()) s.node_weight[i] = g.node_weight[u];
+		if (g.names.size() == (size_t)n) s.add_name(g.names[u]);
+	}
+	return csr_graph::adopt(std::move(s));
+}
+
+/*** to_original() takes values indexed by new vertex and returns them indexed by old vertex. ***/
+template <typename T>
+std::vector<T> to_original(const std::vector<T>& values, const vertex_permutation& P) {
+	std::vector<T> out(values.size());
+	for (size_t v = 0; v < P.new_id.size(); v++) { out[v] = values[P.new_id[v]]; }
+	return out;
+}
+
+#endif
@@ -0,0 +1,73 @@
+/**********************************************************************************
+ * FILE:            semiring.h
+ * DESCRIPTION:     Path algebras understood by the generic Dijkstra engine.
+ *                  Each semiring is a struct of static inline functions, so
+ *                  the engine resolves them at compile time:
+ *                      one()          value of the empty path (the source)
+ *                      zero()         value of an unreachable vertex
+ *                      extend(a, w)   value of a path of value a followed by w
+ *                      better(a, b)   true if a is strictly preferred to b
+ *                  extend() must never make a path better, otherwise the
+ *                  greedy choice of Dijkstra's algorithm is not valid.
+ *                  Semirings that are a monotone image of min_sum also map
+ *                  their values to additive costs and back:
+ *                      cost(a)        non-negative cost, cost(extend(a, w)) =
+ *                                     cost(a) + cost(w), better <=> cheaper
+ *                      from_cost(c)   the value whose cost is c
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef SEMIRING_H
+#define SEMIRING_H
+
+#include <limits>
+#include <cmath>
+
+/*** max_product: most reliable path. The safety of a path is the product of the safety
+probabilities of its edges (exercise 25). ***/
+struct max_product {
+	static double one() { return 1.0; }
+	static double zero() { return 0.0; }
+	static double extend(double a, double w) { return a * w; }
+	static bool better(double a, double b) { return a > b; }
+	static double cost(double a) { return -std::log(a); }
+	static double from_cost(double c) { return std::exp(-c); }
+};
+
+/*** noisy_or: least risky path. A path is dangerous if any of its elements is, so risks
+combine as 1 - (1 - a)(1 - w) = a + w - a*w (exercise 26). ***/
+struct noisy_or {
+	static double one() { return 0.0; }
+	static double zero() { return 1.0; }
+	static double extend(double a, double w) { return a + w - a * w; }
+	static bool better(double a, double b) { return a < b; }
+	static double cost(double a) { return -std::log1p(-a); }
+	static double from_cost(double c) { return -std::expm1(-c); }
+};
+
+/*** min_sum: classical shortest path with additive non-negative weights. ***/
+struct min_sum {
+	static double one() { return 0.0; }
+	static double zero() { return std::numeric_limits<double>::infinity(); }
+	static double extend(double a, double w) { return a + w; }
+	static bool better(double a, double b) { return a < b; }
+	static double cost(double a) { return a; }
+	static double from_cost(double c) { return c; }
+};
+
+/*** bottleneck: widest path. The capacity of a path is that of its narrowest edge. ***/
+struct bottleneck {
+	static double one() { return std::numeric_limits<double>::infinity(); }
+	static double zero() { return -std::numeric_limits<double>::infinity(); }
+	static double extend(double a, double w) { return (w < a) ? w : a; }
+	static bool better(double a, double b) { return a > b; }
+};
+
+/*** semiring_order<S> adapts S::better() to the Compare argument of indexed_heap. ***/
+template <typename Semiring>
+struct semiring_order {
+	bool operator()(double a, double b) const { return Semiring::better(a, b); }
+};
+
+#endif
@@ -0,0 +1,216 @@
+/**********************************************************************************
+ * FILE:            snapshot.h
+ * DESCRIPTION:     Binary snapshot of a csr_graph that can be mapped read-only
+ *                  and used in place, with no parse and no copy. Several
+ *                  processes that open the same snapshot share one copy of it
+ *                  in the page cache.
+ *
+ *                  Layout (version 2, native little-endian, every section
+ *                  starts at a multiple of 8 bytes):
+ *                      snapshot_header
+ *                      offsets       (n + 1) x int64
+ *                      targets       m x int32
+ *                      weights       m x float64
+ *                      node_weight   n x float64, if SNAPSHOT_NODE_WEIGHTS
+ *                      name_start    (n + 1) x int64
+ *                      name_chars    name_start[n] bytes
+ *                  graph_id is a hash of all sections: two snapshots with the
+ *                  same graph_id hold the same graph. SNAPSHOT_DIRECTED tells
+ *                  whether the arcs were read as directed, so that a snapshot
+ *                  is not used by a program that expects the other kind.
+ *                  A snapshot is checked when opened: its sections must lie
+ *                  inside the file, aligned, its offsets and name starts must
+ *                  never decrease, and every arc must lead to one of its
+ *                  vertices. This costs one pass over the mapping, no copy.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include "csr_graph.h"
+#include "mapped_file.h"
+#include "loader.h"
+
+const char SNAPSHOT_MAGIC[8] = { 'D', 'J', 'K', 'S', 'N', 'A', 'P', '\0' };
+const uint32_t SNAPSHOT_VERSION = 2;
+const uint32_t SNAPSHOT_ENDIAN = 0x01020304;
+const uint32_t SNAPSHOT_NODE_WEIGHTS = 1;
+const uint32_t SNAPSHOT_DIRECTED = 2;
+
+struct snapshot_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t endian;
+	uint32_t flags;
+	uint32_t reserved;
+	uint64_t graph_id;
+	int64_t num_vertices;
+	int64_t num_arcs;
+	// byte offsets of the sections from the start of the file
+	uint64_t offsets_at;
+	uint64_t targets_at;
+	uint64_t weights_at;
+	uint64_t node_weight_at;
+	uint64_t name_start_at;
+	uint64_t name_chars_at;
+	uint64_t file_size;
+};
+
+/*** fnv1a() folds len bytes into the running 64-bit FNV-1a hash h. ***/
+inline uint64_t fnv1a(uint64_t h, const void* data, size_t len) {
+	const unsigned char* p = (const unsigned char*)data;
+	for (size_t i = 0; i < len; i++) {
+		h ^= p[i];
+		h *= 1099511628211ull;
+	}
+	return h;
+}
+
+/*** graph_id() hashes the arrays of a graph, as stored in the header of its snapshot. ***/
+inline uint64_t graph_id(const csr_graph& g) {
+	uint64_t h = 14695981039346656037ull;
+	h = fnv1a(h, g.offsets.data(), g.offsets.size() * sizeof(int64_t));
+	h = fnv1a(h, g.targets.data(), g.targets.size() * sizeof(int));
+	h = fnv1a(h, g.weights.data(), g.weights.size() * sizeof(double));
+	h = fnv1a(h, g.node_weight.data(), g.node_weight.size() * sizeof(double));
+	h = fnv1a(h, g.names.start.data(), g.names.start.size() * sizeof(int64_t));
+	h = fnv1a(h, g.names.chars.data(), g.names.chars.size());
+	return h;
+}
+
+/*** write_snapshot() saves the graph to path, recording whether its arcs are directed, throwing
+std::runtime_error on failure. ***/
+inline void write_snapshot(const csr_graph& g, const std::string& path, bool directed) {
+	static_assert(sizeof(int) == 4, "snapshots store 32-bit vertex ids");
+	snapshot_header h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, SNAPSHOT_MAGIC, sizeof(h.magic));
+	h.version = SNAPSHOT_VERSION;
+	h.endian = SNAPSHOT_ENDIAN;
+	h.flags = (g.has_node_weights() ? SNAPSHOT_NODE_WEIGHTS : 0) | (directed ? SNAPSHOT_DIRECTED : 0);
+	h.graph_id = graph_id(g);
+	h.num_vertices = g.num_vertices();
+	h.num_arcs = g.num_arcs();
+
+	auto align = [](uint64_t at) { return (at + 7) & ~(uint64_t)7; };
+	uint64_t at = align(sizeof(snapshot_header));
+	h.offsets_at = at;		at = align(at + g.offsets.size() * sizeof(int64_t));
+	h.targets_at = at;		at = align(at + g.targets.size() * sizeof(int));
+	h.weights_at = at;		at = align(at + g.weights.size() * sizeof(double));
+	h.node_weight_at = at;	at = align(at + g.node_weight.size() * sizeof(double));
+	h.name_start_at = at;	at = align(at + g.names.start.size() * sizeof(int64_t));
+	h.name_chars_at = at;	at = at + g.names.chars.size();
+	h.file_size = at;
+
+	FILE* f = fopen(path.c_str(), "wb");
+	if (f == NULL) throw std::runtime_error("cannot write " + path);
+	bool ok = true;
+	uint64_t written = 0;
+	auto put = [&](uint64_t where, const void* data, size_t len) {
+		static const char zeros[8] = { 0 };
+		if (where > written) ok = ok && fwrite(zeros, 1, (size_t)(where - written), f) == where - written;
+		if (len > 0) ok = ok && fwrite(data, 1, len, f) == len;
+		written = where + len;
+	};
+	put(0, &h, sizeof(h));
+	put(h.offsets_at, g.offsets.data(), g.offsets.size() * sizeof(int64_t));
+	put(h.targets_at, g.targets.data(), g.targets.size() * sizeof(int));
+	put(h.weights_at, g.weights.data(), g.weights.size() * sizeof(double));
+	put(h.node_weight_at, g.node_weight.data(), g.node_weight.size() * sizeof(double));
+	put(h.name_start_at, g.names.start.data(), g.names.start.size() * sizeof(int64_t));
+	put(h.name_chars_at, g.names.chars.data(), g.names.chars.size());
+	if (fclose(f) != 0 || !ok) throw std::runtime_error("cannot write " + path);
+}
+
+/*** is_snapshot() tells whether the file at path starts with the snapshot magic. ***/
+inline bool is_snapshot(const std::string& path) {
+	FILE* f = fopen(path.c_str(), "rb");
+	if (f == NULL) return false;
+	char magic[8];
+	bool yes = fread(magic, 1, sizeof(magic), f) == sizeof(magic) && memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0;
+	fclose(f);
+	return yes;
+}
+
+/*** section_fits() tells whether count elements of T starting at byte at lie inside a file of
+size bytes, aligned for T. ***/
+template <typename T>
+bool section_fits(uint64_t at, uint64_t count, uint64_t size) {
+	return at % alignof(T) == 0 && at <= size && count <= (size - at) / sizeof(T);
+}
+
+/*** open_snapshot() maps a snapshot and returns a graph that reads straight from the
+mapping, which stays open as long as any copy of the graph is alive. If id is not null,
+it receives the graph_id of the snapshot, and if directed is not null, whether its arcs
+are directed. ***/
+inline csr_graph open_snapshot(const std::string& path, uint64_t* id = nullptr, bool* directed = nullptr) {
+	std::shared_ptr<mapped_file> file = std::make_shared<mapped_file>();
+	if (!file->open(path)) throw std::runtime_error("cannot open " + path);
+	if (file->size() < sizeof(snapshot_header)) throw std::runtime_error(path + " is not a graph snapshot");
+	const char* base = file->data();
+	snapshot_header h;
+	memcpy(&h, base, sizeof(h));
+	if (memcmp(h.magic, SNAPSHOT_MAGIC, sizeof(h.magic)) != 0) throw std::runtime_error(path + " is not a graph snapshot");
+	if (h.version != SNAPSHOT_VERSION) throw std::runtime_error(path + " has an unsupported snapshot version");
+	if (h.endian != SNAPSHOT_ENDIAN) throw std::runtime_error(path + " was written on a machine of different endianness");
+	if (h.file_size != file->size()) throw std::runtime_error(path + " is truncated");
+
+	if (h.num_vertices < 0 || h.num_vertices >= INT32_MAX || h.num_arcs < 0) throw std::runtime_error(path + " has a corrupt header");
+	uint64_t n = (uint64_t)h.num_vertices;
+	uint64_t m = (uint64_t)h.num_arcs;
+	bool fits = section_fits<int64_t>(h.offsets_at, n + 1, h.file_size) && section_fits<int>(h.targets_at, m, h.file_size)
+		&& section_fits<double>(h.weights_at, m, h.file_size) && section_fits<int64_t>(h.name_start_at, n + 1, h.file_size)
+		&& section_fits<char>(h.name_chars_at, 0, h.file_size);
+	if (h.flags & SNAPSHOT_NODE_WEIGHTS) fits = fits && section_fits<double>(h.node_weight_at, n, h.file_size);
+	if (!fits) throw std::runtime_error(path + " has a section misaligned or outside the file");
+	const int64_t* offsets = (const int64_t*)(base + h.offsets_at);
+	const int64_t* name_start = (const int64_t*)(base + h.name_start_at);
+	if (offsets[0] != 0 || offsets[n] != h.num_arcs) throw std::runtime_error(path + " has offsets that do not match its arcs");
+	if (name_start[0] != 0 || name_start[n] < 0 || (uint64_t)name_start[n] > h.file_size - h.name_chars_at) {
+		throw std::runtime_error(path + " has names outside the file");
+	}
+	// one pass over the mapped arrays, so that a corrupt snapshot fails here and not inside a search
+	const int* targets = (const int*)(base + h.targets_at);
+	for (uint64_t v = 0; v < n; v++) {
+		if (offsets[v] > offsets[v + 1]) throw std::runtime_error(path + " has offsets that do not match its arcs");
+		if (name_start[v] > name_start[v + 1]) throw std::runtime_error(path + " has names outside the file");
+	}
+	for (uint64_t e = 0; e < m; e++) {
+		if (targets[e] < 0 || (uint64_t)targets[e] >= n) throw std::runtime_error(path + " has an arc to a vertex it does not have");
+	}
+
+	csr_graph g;
+	g.offsets = array_view<int64_t>(offsets, n + 1);
+	g.targets = array_view<int>(targets, m);
+	g.weights = array_view<double>((const double*)(base + h.weights_at), m);
+	if (h.flags & SNAPSHOT_NODE_WEIGHTS) g.node_weight = array_view<double>((const double*)(base + h.node_weight_at), n);
+	g.names.start = array_view<int64_t>(name_start, n + 1);
+	g.names.chars = array_view<char>(base + h.name_chars_at, (size_t)(h.file_size - h.name_chars_at));
+	g.owner = file;
+	if (id != nullptr) *id = h.graph_id;
+	if (directed != nullptr) *directed = (h.flags & SNAPSHOT_DIRECTED) != 0;
+	return g;
+}
+
+/*** open_graph() opens a snapshot, or parses an edge list if the file is not one. A snapshot
+must have been written with the same directed as asked for. If the file is a snapshot and id
+is not null, id receives its graph_id. ***/
+inline csr_graph open_graph(const std::string& path, bool directed, uint64_t* id = nullptr) {
+	if (!is_snapshot(path)) return load_edge_list(path, directed);
+	bool snapshot_directed;
+	csr_graph g = open_snapshot(path, id, &snapshot_directed);
+	if (snapshot_directed != directed) {
+		throw std::runtime_error(path + " is a snapshot of " + (snapshot_directed ? "a directed" : "an undirected") + " graph");
+	}
+	return g;
+}
+
+#endif
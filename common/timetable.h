@@ -0,0 +1,169 @@
+/**********************************************************************************
+ * FILE:            timetable.h
+ * DESCRIPTION:     Earliest-arrival routing over a timetable with the Connection
+ *                  Scan Algorithm. Every flight is a connection between two
+ *                  airports, and all connections are kept in one array sorted
+ *                  by departure time, so a query is a single linear scan with
+ *                  no priority queue. As in exercise 12, a flight can be taken
+ *                  if it departs strictly after we arrive at its origin.
+ *                  Times are minutes since 1970-01-01.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef TIMETABLE_H
+#define TIMETABLE_H
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <cstdio>
+
+/*** minutes_from_civil() converts a date and a time given as hhmm, as in the dep_time and
+arr_time columns, into minutes since 1970-01-01. hhmm = 2400 is midnight of the next day. ***/
+inline int64_t minutes_from_civil(int year, int month, int day, int hhmm) {
+	// days from civil, proleptic Gregorian calendar
+	year -= month <= 2;
+	int64_t era = (year >= 0 ? year : year - 399) / 400;
+	int64_t yoe = year - era * 400;
+	int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+	int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+	int64_t days = era * 146097 + doe - 719468;
+	return days * 1440 + (hhmm / 100) * 60 + hhmm % 100;
+}
+
+/*** format_minutes() prints minutes since 1970-01-01 as "YYYY-MM-DD HH:MM:SS". ***/
+inline std::string format_minutes(int64_t t) {
+	int64_t days = (t >= 0 ? t : t - 1439) / 1440;
+	int64_t mins = t - days * 1440;
+	// civil from days
+	days += 719468;
+	int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+	int64_t doe = days - era * 146097;
+	int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	int64_t mp = (5 * doy + 2) / 153;
+	int day = (int)(doy - (153 * mp + 2) / 5 + 1);
+	int month = (int)(mp < 10 ? mp + 3 : mp - 9);
+	int year = (int)(yoe + era * 400 + (month <= 2));
+	char buf[32];
+	snprintf(buf, sizeof(buf), "%04d-%02d-%02d %02d:%02d:00", year, month, day, (int)(mins / 60), (int)(mins % 60));
+	return buf;
+}
+
+/*** A connection is one flight. id is its row in the input, as the flight_id of exercise 12. ***/
+struct connection {
+	int dep_stop;
+	int arr_stop;
+	int64_t dep_time;
+	int64_t arr_time;
+	int64_t id;
+};
+
+/*** One Pareto-optimal option of a profile query: leave at dep_time, arrive at arr_time. ***/
+struct profile_entry {
+	int64_t dep_time;
+	int64_t arr_time;
+};
+
+class timetable {
+public:
+	static constexpr int64_t never = std::numeric_limits<int64_t>::max();
+	static constexpr int64_t always = std::numeric_limits<int64_t>::min();
+
+	/*** stop() returns the id of the airport with the given code, adding it if it is new. ***/
+	int stop(const std::string& code) {
+		std::unordered_map<std::string, int>::iterator it = index.find(code);
+		if (it != index.end()) return it->second;
+		index[code] = (int)names.size();
+		names.push_back(code);
+		return (int)names.size() - 1;
+	}
+
+	/*** find_stop() returns the id of an airport, or -1 if there is no such code. ***/
+	int find_stop(const std::string& code) const {
+		std::unordered_map<std::string, int>::const_iterator it = index.find(code);
+		return (it == index.end()) ? -1 : it->second;
+	}
+
+	const std::string& name(int s) const { return names[s]; }
+	int num_stops() const { return (int)names.size(); }
+	size_t num_connections() const { return connections.size(); }
+	const connection& get(size_t c) const { return connections[c]; }
+
+	void add_connection(int dep_stop, int arr_stop, int64_t dep_time, int64_t arr_time, int64_t id) {
+		connections.push_back({ dep_stop, arr_stop, dep_time, arr_time, id });
+	}
+
+	/*** finalize() sorts the connections by departure time. Call it once after loading. ***/
+	void finalize() {
+		std::stable_sort(connections.begin(), connections.end(),
+			[](const connection& a, const connection& b) { return a.dep_time < b.dep_time; });
+	}
+
+	/*** earliest_arrival() scans the connections that leave after depart_at and returns the
+	indices of the connections of the journey from source to target, in travel order. The
+	journey is empty if target cannot be reached. ***/
+	std::vector<size_t> earliest_arrival(int source, int target, int64_t depart_at = always) const {
+		std::vector<int64_t> arrival(names.size(), never);
+		std::vector<size_t> in_connection(names.size(), none);
+		arrival[source] = depart_at;
+		std::vector<connection>::const_iterator first = std::upper_bound(connections.begin(), connections.end(), depart_at,
+			[](int64_t t, const connection& c) { return t < c.dep_time; });
+		for (size_t c = first - connections.begin(); c < connections.size(); c++) {
+			const connection& conn = connections[c];
+			if (conn.dep_time >= arrival[target]) break;	// nothing later can arrive earlier
+			if (arrival[conn.dep_stop] < conn.dep_time && conn.arr_time < arrival[conn.arr_stop]) {
+				arrival[conn.arr_stop] = conn.arr_time;
+				in_connection[conn.arr_stop] = c;
+			}
+		}
+		// backtrack from target following the flight that took us to every airport
+		std::vector<size_t> journey;
+		if (source == target || in_connection[target] == none) return journey;
+		for (int s = target; s != source; s = connections[in_connection[s]].dep_stop) {
+			journey.push_back(in_connection[s]);
+		}
+		std::reverse(journey.begin(), journey.end());
+		return journey;
+	}
+
+	/*** profile() answers "when should I leave source to reach target?" for every departure
+	time at once. It scans the connections backwards keeping, for every airport, the Pareto
+	set of (departure, arrival) options, and returns the set of source by ascending time. ***/
+	std::vector<profile_entry> profile(int source, int target) const {
+		// profiles[s] holds entries by decreasing dep_time and strictly decreasing arr_time
+		std::vector<std::vector<profile_entry>> profiles(names.size());
+		for (size_t c = connections.size(); c-- > 0;) {
+			const connection& conn = connections[c];
+			int64_t arr = (conn.arr_stop == target) ? conn.arr_time : earliest_after(profiles[conn.arr_stop], conn.arr_time);
+			if (arr == never) continue;
+			std::vector<profile_entry>& P = profiles[conn.dep_stop];
+			if (!P.empty() && P.back().arr_time <= arr) continue;	// dominated
+			if (!P.empty() && P.back().dep_time == conn.dep_time) P.back().arr_time = arr;
+			else P.push_back({ conn.dep_time, arr });
+		}
+		std::vector<profile_entry> result(profiles[source].rbegin(), profiles[source].rend());
+		return result;
+	}
+
+private:
+	static constexpr size_t none = std::numeric_limits<size_t>::max();
+	std::vector<std::string> names;
+	std::unordered_map<std::string, int> index;
+	std::vector<connection> connections;
+
+	/*** earliest_after() returns the earliest arrival in P departing strictly after t. ***/
+	static int64_t earliest_after(const std::vector<profile_entry>& P, int64_t t) {
+		// the last entry with dep_time > t has the smallest such departure and so the best arrival
+		std::vector<profile_entry>::const_iterator it = std::partition_point(P.begin(), P.end(),
+			[t](const profile_entry& e) { return e.dep_time > t; });
+		if (it == P.begin()) return never;
+		return (it - 1)->arr_time;
+	}
+};
+
+#endif
@@ -0,0 +1,142 @@
+/**********************************************************************************
+ * FILE:            trace.h
+ * DESCRIPTION:     Compile-time trace levels and operation counters.
+ *                  TRACE_LEVEL is set when compiling (-DTRACE_LEVEL=n):
+ *                      0   nothing: the macros below compile to nothing
+ *                      1   counters and phase timers, printed to stderr as one
+ *                          JSON object when the program exits
+ *                      2   also the step by step trace of the exercises, the
+ *                          default, as the programs have always printed it.
+ *                          The programs only print it on their built-in
+ *                          example graphs: on a graph read from a file it
+ *                          would be far longer than the result, and slower.
+ *                  Counters are kept per thread and added up when a thread
+ *                  ends, so counting never takes a lock.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#ifndef TRACE_LEVEL
+#define TRACE_LEVEL 2
+#endif
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <utility>
+#include <mutex>
+#include <chrono>
+
+struct trace_counters {
+	uint64_t relaxations = 0;
+	uint64_t decrease_keys = 0;
+	uint64_t heap_pushes = 0;
+	uint64_t heap_pops = 0;
+	uint64_t unions = 0;
+	uint64_t finds = 0;
+
+	void add(const trace_counters& c) {
+		relaxations += c.relaxations;
+		decrease_keys += c.decrease_keys;
+		heap_pushes += c.heap_pushes;
+		heap_pops += c.heap_pops;
+		unions += c.unions;
+		finds += c.finds;
+	}
+};
+
+/*** trace_totals gathers the counters of the threads that have ended and the time spent in
+every phase, and prints them when it is destroyed at exit. ***/
+class trace_totals {
+public:
+	static trace_totals& get() {
+		static trace_totals totals;
+		return totals;
+	}
+
+	void add(const trace_counters& c) {
+		std::lock_guard<std::mutex> lock(m);
+		sum.add(c);
+	}
+
+	void add_phase(const char* name, double seconds) {
+		std::lock_guard<std::mutex> lock(m);
+		for (size_t i = 0; i < phases.size(); i++) {
+			if (phases[i].first == name) { phases[i].second += seconds; return; }
+		}
+		phases.push_back(std::make_pair(std::string(name), seconds));
+	}
+
+	~trace_totals() {
+		fprintf(stderr, "{\"relaxations\": %llu, \"decrease_keys\": %llu, \"heap_pushes\": %llu, \"heap_pops\": %llu, "
+			"\"unions\": %llu, \"finds\": %llu, \"phases\": {", (unsigned long long)sum.relaxations, (unsigned long long)sum.decrease_keys,
+			(unsigned long long)sum.heap_pushes, (unsigned long long)sum.heap_pops, (unsigned long long)sum.unions, (unsigned long long)sum.finds);
+		for (size_t i = 0; i < phases.size(); i++) { fprintf(stderr, "%s\"%s\": %.6f", i ? ", " : "", phases[i].first.c_str(), phases[i].second); }
+		fprintf(stderr, "}}\n");
+	}
+
+private:
+	std::mutex m;
+	trace_counters sum;
+	std::vector<std::pair<std::string, double>> phases;		// in order of first use
+};
+
+/*** trace_local is the counters of one thread, added to the totals when the thread ends.
+The totals are created first, so that they outlive the counters of the main thread. ***/
+struct trace_local {
+	trace_counters c;
+
+	static trace_counters& get() {
+		static trace_totals& totals = trace_totals::get();
+		(void)totals;
+		thread_local trace_local local;
+		return local.c;
+	}
+
+	~trace_local() { trace_totals::get().add(c); }
+};
+
+/*** trace_phase adds the time between its construction and its destruction to a phase. ***/
+class trace_phase {
+public:
+	explicit trace_phase(const char* name) : name(name), start(std::chrono::steady_clock::now()) {}
+	~trace_phase() { trace_totals::get().add_phase(name, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()); }
+
+private:
+	const char* name;
+	std::chrono::steady_clock::time_point start;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+#if TRACE_LEVEL >= 1
+#define TRACE_ADD(counter, n) (trace_local::get().counter += (n))
+#define TRACE_COUNT(counter) TRACE_ADD(counter, 1)
+#define TRACE_PHASE(name) trace_phase TRACE_CONCAT(trace_phase_, __LINE__)(name)
+#else
+#define TRACE_ADD(counter, n) ((void)0)
+#define TRACE_COUNT(counter) ((void)0)
+#define TRACE_PHASE(name) ((void)0)
+#endif
+
+/*** trace_steps() tells whether TRACE() runs at level 2. A program turns it off when it reads
+its graph from a file. ***/
+inline bool& trace_steps() {
+	static bool on = true;
+	return on;
+}
+
+/*** TRACE(statements) runs the statements only at level 2, and while trace_steps() is on, such
+as the printing of every step of an algorithm. ***/
+#if TRACE_LEVEL >= 2
+#define TRACE(...) do { if (trace_steps()) { __VA_ARGS__; } } while (0)
+#else
+#define TRACE(...) do {} while (0)
+#endif
+
+#endif
@@ -0,0 +1,289 @@
+/**********************************************************************************
+ * FILE:            tree_cache.h
+ * DESCRIPTION:     Cache of complete shortest path trees, for sources that are
+ *                  asked for again and again. A tree keeps, for every vertex,
+ *                  its predecessor as a 32-bit index and its value as a float,
+ *                  8 bytes per vertex, so that a query from a cached source is
+ *                  only a walk back from the target. The value printed is then
+ *                  folded again along that path, which gives the same double,
+ *                  bit for bit, as the search did.
+ *                  The trees in memory are kept under a cap in bytes, and the
+ *                  least recently used leave first. If a spill file is given,
+ *                  they are appended to it and read back through a memory
+ *                  mapping when asked for again. The file starts with the
+ *                  graph_id() of the graph (snapshot.h): a file written for
+ *                  another graph, or another version of it, is emptied when
+ *                  opened, and one written for this graph is used as it is.
+ *                  A file that is not empty and is not a tree cache is left
+ *                  alone, and the cache refuses to open.
+ *                  The cache may be shared by several threads.
+ *
+ *                  Spill file layout (version 1, native little-endian):
+ *                      tree_cache_header
+ *                      every tree: key as uint64, source as uint32, then
+ *                      n x uint32 pred and n x float32 value
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#ifndef TREE_CACHE_H
+#define TREE_CACHE_H
+
+#include <vector>
+#include <list>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include "arena.h"
+#include "csr_graph.h"
+#include "dijkstra.h"
+#include "mapped_file.h"
+#include "snapshot.h"
+
+const char TREE_CACHE_MAGIC[8] = { 'D', 'J', 'K', 'T', 'R', 'E', 'E', 'S' };
+const uint32_t TREE_CACHE_VERSION = 1;
+
+struct tree_cache_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t num_vertices;
+	uint64_t graph_id;		// graph_id() of the graph the trees were grown in
+};
+
+/*** compact_tree is a shortest path tree of n vertices. Vertices not reached have no
+predecessor, and neither has the source. ***/
+struct compact_tree {
+	static constexpr uint32_t none = 0xFFFFFFFFu;
+	uint32_t source = 0;
+	std::vector<uint32_t> pred;
+	std::vector<float> value;
+
+	size_t bytes() const { return pred.size() * sizeof(uint32_t) + value.size() * sizeof(float); }
+	bool reached(int v) const { return (uint32_t)v == source || pred[v] != none; }
+};
+
+/*** compact() copies the tree of the last search of ws, which must have covered the whole graph. ***/
+template <typename Semiring, typename Queue>
+std::shared_ptr<const compact_tree> compact(const sssp_workspace<Semiring, Queue>& ws, int source, int n) {
+	std::shared_ptr<compact_tree> T = std::make_shared<compact_tree>();
+	T->source = (uint32_t)source;
+	T->pred.resize(n);
+	T->value.resize(n);
+	for (int v = 0; v < n; v++) {
+		int p = ws.pred(v);
+		T->pred[v] = (p == -1) ? compact_tree::none : (uint32_t)p;
+		T->value[v] = (float)ws.value(v);
+	}
+	return T;
+}
+
+/*** tree_path() returns the vertices from the source of T to t, in the arena a, or nothing if
+t was not reached. ***/
+inline array_view<int> tree_path(const compact_tree& T, int t, arena& a) {
+	if (!T.reached(t)) return array_view<int>();
+	size_t len = 1;
+	for (uint32_t x = (uint32_t)t; x != T.source; x = T.pred[x]) { len++; }
+	int* p = a.allocate_array<int>(len);
+	uint32_t x = (uint32_t)t;
+	for (size_t i = len; i > 0; x = T.pred[x]) { p[--i] = (int)x; }
+	return array_view<int>(p, len);
+}
+
+/*** path_value<S>() folds the value of a path of g as dijkstra.h does, through the best arc
+between every two vertices, vertex weights included. ***/
+template <typename Semiring>
+double path_value(const csr_graph& g, array_view<int> path) {
+	double value = Semiring::one();
+	if (g.has_node_weights()) value = Semiring::extend(value, g.node_weight[path[0]]);
+	for (size_t i = 1; i < path.size(); i++) {
+		int u = path[i - 1], v = path[i];
+		double best = Semiring::zero();
+		for (int64_t e = g.begin(u); e < g.end(u); e++) {
+			if (g.targets[e] != v) continue;
+			double w = g.weights[e];
+			if (g.has_node_weights()) w = Semiring::extend(w, g.node_weight[v]);
+			double c = Semiring::extend(value, w);
+			if (Semiring::better(c, best)) best = c;
+		}
+		value = best;
+	}
+	return value;
+}
+
+/*** tree_cache maps keys, such as a source and the semantics of its search, to trees of the
+graph it was made for. ***/
+class tree_cache {
+public:
+	/*** The cache keeps up to memory_bytes of trees of n vertices in memory, and spills the
+	others to spill_path if it is not empty, throwing std::runtime_error if it cannot. ***/
+	tree_cache(int n, uint64_t id, size_t memory_bytes, const std::string& spill_path = "")
+		: n(n), id(id), cap(memory_bytes), path(spill_path) {
+		if (!path.empty()) open_spill();
+	}
+
+	~tree_cache() {
+		if (spill != nullptr) fclose(spill);
+	}
+
+	tree_cache(const tree_cache&) = delete;
+	tree_cache& operator=(const tree_cache&) = delete;
+
+	/*** find() returns the tree of key, or nothing. A tree found in the spill file is read back
+	into memory. ***/
+	std::shared_ptr<const compact_tree> find(uint64_t key) {
+		std::lock_guard<std::mutex> lock(m);
+		std::unordered_map<uint64_t, entry>::iterator it = entries.find(key);
+		if (it == entries.end()) {
+			misses++;
+			return std::shared_ptr<const compact_tree>();
+		}
+		hits++;
+		entry& e = it->second;
+		if (e.tree) {
+			recent.splice(recent.begin(), recent, e.place);
+			return e.tree;
+		}
+		e.tree = load(e.record);
+		reloads++;
+		recent.push_front(key);
+		e.place = recent.begin();
+		held += e.tree->bytes();
+		trim();
+		return e.tree;
+	}
+
+	/*** insert() adds the tree of key, unless another thread did first, and returns the tree
+	kept. ***/
+	std::shared_ptr<const compact_tree> insert(uint64_t key, std::shared_ptr<const compact_tree> T) {
+		std::lock_guard<std::mutex> lock(m);
+		std::pair<std::unordered_map<uint64_t, entry>::iterator, bool> ins = entries.emplace(key, entry());
+		entry& e = ins.first->second;
+		if (e.tree) return e.tree;
+		e.tree = T;
+		recent.push_front(key);
+		e.place = recent.begin();
+		held += T->bytes();
+		trim();
+		return T;
+	}
+
+	size_t num_hits() const { return hits; }
+	size_t num_misses() const { return misses; }
+	size_t num_reloads() const { return reloads; }
+	size_t num_spilled() const { return spilled; }
+
+private:
+	struct entry {
+		std::shared_ptr<const compact_tree> tree;	// null while it is only in the spill file
+		std::list<uint64_t>::iterator place;		// in recent, if in memory
+		int64_t record = -1;						// in the spill file, or -1
+	};
+
+	int n;
+	uint64_t id;
+	size_t cap;
+	std::string path;
+	std::mutex m;
+	std::unordered_map<uint64_t, entry> entries;
+	std::list<uint64_t> recent;			// keys of the trees in memory, most recent first
+	size_t held = 0;					// bytes of the trees in memory
+	std::FILE* spill = nullptr;
+	int64_t records = 0;
+	mapped_file mapped;
+	size_t hits = 0, misses = 0, reloads = 0, spilled = 0;
+
+	size_t record_bytes() const { return sizeof(uint64_t) + sizeof(uint32_t) + (size_t)n * (sizeof(uint32_t) + sizeof(float)); }
+	size_t record_offset(int64_t r) const { return sizeof(tree_cache_header) + (size_t)r * record_bytes(); }
+
+	/*** open_spill() opens the spill file, keeping its trees if they were grown in this graph. It
+	only empties a file that is a tree cache or is already empty. ***/
+	void open_spill() {
+		spill = fopen(path.c_str(), "r+b");
+		tree_cache_header h;
+		bool ours = false;
+		if (spill != nullptr) {
+			size_t got = fread(&h, 1, sizeof(h), spill);
+			bool cache = got == sizeof(h) && memcmp(h.magic, TREE_CACHE_MAGIC, sizeof(h.magic)) == 0;
+			if (!cache && got > 0) {
+				fclose(spill);
+				spill = nullptr;
+				throw std::runtime_error(path + " is not a tree cache file");
+			}
+			ours = cache && h.version == TREE_CACHE_VERSION && h.num_vertices == (uint32_t)n && h.graph_id == id;
+		}
+		if (ours) {
+			if (!mapped.open(path)) {
+				fclose(spill);
+				spill = nullptr;
+				throw std::runtime_error("cannot map " + path);
+			}
+			records = (int64_t)((mapped.size() - sizeof(h)) / record_bytes());
+			for (int64_t r = 0; r < records; r++) {
+				uint64_t key;
+				memcpy(&key, mapped.data() + record_offset(r), sizeof(key));
+				entries[key].record = r;
+			}
+			return;
+		}
+		// a cache of another graph or version, an empty file or no file: start again
+		if (spill != nullptr) fclose(spill);
+		spill = fopen(path.c_str(), "w+b");
+		if (spill == nullptr) throw std::runtime_error("cannot write " + path);
+		memset(&h, 0, sizeof(h));
+		memcpy(h.magic, TREE_CACHE_MAGIC, sizeof(h.magic));
+		h.version = TREE_CACHE_VERSION;
+		h.num_vertices = (uint32_t)n;
+		h.graph_id = id;
+		if (fwrite(&h, sizeof(h), 1, spill) != 1 || fflush(spill) != 0) throw std::runtime_error("cannot write " + path);
+	}
+
+	/*** trim() moves the least recently used trees out of memory until they fit under the cap,
+	always keeping the most recent one. ***/
+	void trim() {
+		while (held > cap && recent.size() > 1) {
+			uint64_t key = recent.back();
+			recent.pop_back();
+			entry& e = entries[key];
+			held -= e.tree->bytes();
+			if (spill != nullptr && e.record == -1) e.record = save(key, *e.tree);
+			e.tree.reset();
+			if (e.record == -1) entries.erase(key);
+		}
+	}
+
+	/*** save() writes the tree of key after the last whole record of the spill file, over any
+	part of a record left by a write that failed, and returns its record, or -1 if the file
+	cannot take it. ***/
+	int64_t save(uint64_t key, const compact_tree& T) {
+		if (external_seek(spill, (int64_t)record_offset(records), SEEK_SET) != 0) return -1;
+		bool ok = fwrite(&key, sizeof(key), 1, spill) == 1
+			&& fwrite(&T.source, sizeof(uint32_t), 1, spill) == 1
+			&& fwrite(T.pred.data(), sizeof(uint32_t), n, spill) == (size_t)n
+			&& fwrite(T.value.data(), sizeof(float), n, spill) == (size_t)n
+			&& fflush(spill) == 0;
+		if (!ok) return -1;
+		spilled++;
+		return records++;
+	}
+
+	/*** load() reads a tree back from the spill file, mapping the file again if it has grown. ***/
+	std::shared_ptr<const compact_tree> load(int64_t r) {
+		if (record_offset(r + 1) > mapped.size() && !mapped.open(path)) throw std::runtime_error("cannot map " + path);
+		const char* p = mapped.data() + record_offset(r) + sizeof(uint64_t);
+		std::shared_ptr<compact_tree> T = std::make_shared<compact_tree>();
+		T->pred.resize(n);
+		T->value.resize(n);
+		memcpy(&T->source, p, sizeof(uint32_t));
+		p += sizeof(uint32_t);
+		memcpy(T->pred.data(), p, (size_t)n * sizeof(uint32_t));
+		memcpy(T->value.data(), p + (size_t)n * sizeof(uint32_t), (size_t)n * sizeof(float));
+		return T;
+	}
+};
+
+#endif
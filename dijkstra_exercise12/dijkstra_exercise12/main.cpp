@@ -0,0 +1,77 @@
+/**********************************************************************************
+ * FILE:            dijkstra_ex12.cpp
+ * DESCRIPTION:     This program finds the earliest arrival route between two
+ *                  airports in flights.csv. It solves exercise 21 in
+ *                  "Algorithms", by Jeff Erickson, as the Python
+ *                  version does, but with the Connection Scan Algorithm.
+ * DATE:            18/10/2026
+ * AUTHOR:          Nieves Montes Gómez
+ **********************************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include "../../common/timetable.h"
+#include "../../common/loader.h"
+
+using namespace std;
+
+int main(int argc, char** argv) {
+
+// load the data on flights
+	string path = (argc > 1) ? argv[1] : "flights.csv";
+	timetable T;
+	try { load_flights(path, T); }
+	catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
+	cout << "Loaded " << T.num_connections() << " flights between " << T.num_stops() << " airports." << endl;
+	if (T.num_stops() < 2) { cout << "Error: not enough airports." << endl; return 1; }
+
+// select source and destination, at random if they are not given
+	int source, dest;
+	if (argc > 3) {
+		source = T.find_stop(argv[2]);
+		dest = T.find_stop(argv[3]);
+		if (source == -1 || dest == -1) { cout << "Invalid source or destination." << endl; return 1; }
+	}
+	else {
+		srand(time(NULL));
+		source = rand() % T.num_stops();
+		do { dest = rand() % T.num_stops(); } while (dest == source);
+	}
+	bool show_profile = (argc > 4) && string(argv[4]) == "--profile";
+
+/*** CONNECTION SCAN ***/
+	vector <size_t> journey = T.earliest_arrival(source, dest);
+	if (journey.empty()) {
+		cout << "Error: there is no route from " << T.name(source) << " to " << T.name(dest) << "." << endl;
+		return 1;
+	}
+
+// print route to file, from the destination backwards as the Python version
+	string out = T.name(source) + "-" + T.name(dest) + ".txt";
+	ofstream f(out, ios::app);
+	f << "ROUTE FROM " << T.name(source) << " TO " << T.name(dest) << "\n";
+	f << "--------------\n";
+	for (size_t i = journey.size(); i-- > 0;) {
+		const connection& c = T.get(journey[i]);
+		f << c.id << "," << T.name(c.dep_stop) << "," << T.name(c.arr_stop) << ","
+			<< format_minutes(c.dep_time) << "," << format_minutes(c.arr_time) << "\n";
+		f << "--------------\n";
+	}
+	cout << "Route from " << T.name(source) << " to " << T.name(dest) << " with " << journey.size()
+		<< " flights, arriving at " << format_minutes(T.get(journey.back()).arr_time) << ", written to " << out << endl;
+
+// all the Pareto-optimal departures from source
+	if (show_profile) {
+		vector <profile_entry> P = T.profile(source, dest);
+		cout << "Departure\t\tArrival" << endl;
+		for (int i = 0; i < P.size(); i++) {
+			cout << format_minutes(P[i].dep_time) << "\t" << format_minutes(P[i].arr_time) << endl;
+		}
+	}
+
+	return 0;
+}
@@ -9,102 +9,104 @@
 
 #include <iostream>
 #include <string>
-#include <queue>
-#include <algorithm>
 #include <vector>
-#include <utility>
-// check memory leaks
-#define _CRTDBG_MAP_ALLOC
-#include <stdlib.h>
-#include <crtdbg.h>
+#include "../../common/csr_graph.h"
+#include "../../common/dijkstra.h"
+#include "../../common/snapshot.h"
+#include "../../common/point_to_point.h"
+#include "../../common/landmarks.h"
+#include "../../common/trace.h"
 
 using namespace std;
 
-struct node {
-	string name;				
-	bool visited = false;				
-	double saf = 0.f;				
-	struct node* pred = NULL;		
-	vector <pair <struct node*, double>> adjList;	
-};							
-
-/*** Functions to sort a queue of nodes according to descending safety function ***/
-bool priority(node* a, node* b) { return (a->saf > b->saf); }
-void sortQueue(queue <struct node*> &Q) {
-	vector <struct node*> aux;
-	while (!Q.empty()) {
-		aux.push_back(Q.front());
-		Q.pop();
-	}
-	sort(aux.begin(), aux.end(), priority);
-	for (int i = 0; i < aux.size(); i++) { Q.push(aux[i]); }
-}
-
 int main(int argc, char** argv) {
 
-// check memory leaks
-	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
+// arguments: [graph source target] [--search=dijkstra|bidirectional|astar] [--landmarks=K] [--landmarks-file=path]
+	vector <string> args;
+	string search = "dijkstra", landmarks_file;
+	int count = 8;
+	for (int n = 1; n < argc; n++) {
+		string arg = argv[n];
+		if (arg.compare(0, 9, "--search=") == 0) search = arg.substr(9);
+		else if (arg.compare(0, 12, "--landmarks=") == 0) count = atoi(arg.c_str() + 12);
+		else if (arg.compare(0, 17, "--landmarks-file=") == 0) landmarks_file = arg.substr(17);
+		else args.push_back(arg);
+	}
 
+	csr_graph graph;
+	int source, target;
+	if (args.size() >= 3) {
+// read the directed edges from an edge list or a snapshot
+		TRACE_PHASE("load");
+		try { graph = open_graph(args[0], true); }
+		catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
+		source = graph.find_vertex(args[1]);
+		target = graph.find_vertex(args[2]);
+		if (source == -1 || target == -1) { cout << "Invalid source or target." << endl; return 1; }
+	}
+	else {
 // build nodes
-	struct node* VA = new node;		VA->name = "VA";		VA->saf = 1.f;		VA->visited = true;
-	struct node* TN = new node;		TN->name = "TN";		
-	struct node* NV = new node;		NV->name = "NV";		
-	struct node* AZ = new node;		AZ->name = "AZ";		
+		graph_builder G;
+		int VA = G.add_vertex("VA");
+		int TN = G.add_vertex("TN");
+		int NV = G.add_vertex("NV");
+		int AZ = G.add_vertex("AZ");
 
 // build directed edges
-	(VA->adjList).push_back(make_pair(AZ, 0.5));
-	(VA->adjList).push_back(make_pair(TN, 0.7));
-	(VA->adjList).push_back(make_pair(NV, 0.2));
-	(TN->adjList).push_back(make_pair(NV, 0.1));
-	(TN->adjList).push_back(make_pair(AZ, 0.9));
-	(NV->adjList).push_back(make_pair(AZ, 0.5));
-	
-// dump all nodes into a queue
-	queue <struct node*> Q;
-	Q.push(TN); Q.push(NV); Q.push(AZ); Q.push(VA);
-	sortQueue(Q);
+		G.add_arc(VA, AZ, 0.5);
+		G.add_arc(VA, TN, 0.7);
+		G.add_arc(VA, NV, 0.2);
+		G.add_arc(TN, NV, 0.1);
+		G.add_arc(TN, AZ, 0.9);
+		G.add_arc(NV, AZ, 0.5);
+		graph = G.build();
+		source = VA;
+		target = AZ;
+	}
 
-// empty queue to dump visited nodes
-	queue <struct node*> S;
-	
-/*** DIJKSTRA ALGORITHM ***/
-	node* currNode = NULL;
-	node* succ = NULL;
-	vector <pair<struct node*, double>>::iterator it;
-	double p;
-	while (!Q.empty()) {
-		currNode = Q.front();       // extract node of highest saf. function
-		currNode->visited = true;   // set it to "visited"
-		Q.pop();                    // delete it from Q
-		S.push(currNode);           // put it in S
-		if (currNode->saf == 0) {cout << "Sorry, you have been abducted" << endl; break;}
-		if (currNode == AZ) {cout << "Congratulations, you have reached area 51, AZ." << endl; break;}
-		// check all adjacent nodes, but only if they are not in Q
-		for (it = (currNode->adjList).begin(); it != (currNode->adjList).end(); ++it) {
-			succ = it->first;
-			p = it->second;
-			if ((succ->saf < currNode->saf * p) && (succ->visited == false)) succ->saf = currNode->saf * p;
+/*** POINT-TO-POINT SEARCH: bidirectional, or A* with landmark bounds, checked against Dijkstra ***/
+	if (search != "dijkstra") {
+		path_result P;
+		if (search == "bidirectional") {
+			bidirectional_search <max_product> B(graph);
+			P = B.run(source, target);
 		}
-		sortQueue(Q);				// arrange nodes that are left in descending saf.function
+		else if (search == "astar") {
+			try {
+				landmarks <max_product> L = open_landmarks <max_product>(graph, landmarks_file, count);
+				P = astar <max_product>(graph, source, target, landmark_bound <max_product>(L, target));
+			}
+			catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
+		}
+		else { cout << "Error: unknown search " << search << "." << endl; return 1; }
+		sssp_result S = dijkstra <max_product>(graph, source, target);
+		if (!P.reached) { cout << "No path from " << graph.names[source] << " to " << graph.names[target] << "." << endl; return S.reached ? 1 : 0; }
+		cout << "Path:";
+		for (int n = 0; n < P.path.size(); n++) { cout << " " << graph.names[P.path[n]]; }
+		cout << endl << "\tSafety function: " << P.value << (P.value == S.value[target] ? " (same as Dijkstra)" : " (DIFFERENT from Dijkstra)") << endl;
+		cout << "Settled vertices: " << P.settled << " (Dijkstra: " << S.settled.size() << ")" << endl;
+		return P.value == S.value[target] ? 0 : 1;
 	}
 
-// print the result
-	if (currNode == AZ) {
-		cout << "This has been your trip:\n";
-		while (!S.empty()) {
-			cout << "Position: " << S.front()->name << endl;
-			cout << "\tSafety function: " << S.front()->saf << endl;
-			S.pop();
-		}
+/*** DIJKSTRA ALGORITHM: maximize the product of safety probabilities ***/
+	sssp_result S;
+	{
+		TRACE_PHASE("dijkstra");
+		S = dijkstra <max_product>(graph, source, target);
 	}
 
-	else if (Q.empty()) {
+// print the result
+	if (!S.reached) {
+		cout << "Sorry, you have been abducted" << endl;
 		cout << "Error: Dijkstra algorithm did not find an exit." << endl;
 		exit(EXIT_FAILURE);
 	}
-
-// free memory
-	delete VA;	delete TN;	delete NV;	delete AZ;
+	cout << "Congratulations, you have reached area 51, " << graph.names[target] << "." << endl;
+	cout << "This has been your trip:\n";
+	for (int i = 0; i < S.settled.size(); i++) {
+		cout << "Position: " << graph.names[S.settled[i]] << endl;
+		cout << "\tSafety function: " << S.value[S.settled[i]] << endl;
+	}
 
 	return 0;
 }
@@ -9,115 +9,260 @@
 
 #include <iostream>
 #include <string>
-#include <queue>
-#include <algorithm>
 #include <vector>
-#include <stdlib.h>
-#include <crtdbg.h>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include "../../common/csr_graph.h"
+#include "../../common/dijkstra.h"
+#include "../../common/snapshot.h"
+#include "../../common/delta_stepping.h"
+#include "../../common/dynamic_sssp.h"
+#include "../../common/all_pairs.h"
+#include "../../common/point_to_point.h"
+#include "../../common/landmarks.h"
+#include "../../common/reorder.h"
+#include "../../common/trace.h"
 
 using namespace std;
 
-struct node {
-	string name;
-	bool visited = false;
-	double p = 0.f; // parameter of the problem
-	double risk = 1.f;
-	vector <pair<struct node*, double>> adjList;
-};
-
 /*** add_edge() builds an undirected weighted edge between nodes a and b ***/
-void add_edge(node* node_a, node* node_b, float prob) {
-	(node_a->adjList).push_back(make_pair(node_b, prob));
-	(node_b->adjList).push_back(make_pair(node_a, prob));
+void add_edge(graph_builder& G, int node_a, int node_b, float prob) {
+	G.add_edge(node_a, node_b, prob);
 }
 
-/*** Functions to sort a queue of nodes according to ascening risk function ***/
-bool priority(node* a, node* b) { return (a->risk < b->risk); }
-void sortQueue(queue <struct node*>& Q) {
-	vector <struct node*> aux;
-	while (!Q.empty()) {
-		aux.push_back(Q.front());
-		Q.pop();
+/*** risk_matrix() computes the risk between every two nodes with the Floyd-Warshall kernel,
+prints the matrix of small networks, and compares every row with a Dijkstra search from its
+node. It returns whether they agree up to rounding. ***/
+bool risk_matrix(const csr_graph& graph, unsigned threads, fw_kernel kernel) {
+	int n = graph.num_vertices();
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	all_pairs <noisy_or> A(graph, threads, kernel);
+	double seconds = chrono::duration <double>(chrono::steady_clock::now() - begin).count();
+	cout << "All pairs of " << n << " nodes in " << seconds << " s (" << kernel_name(kernel) << " kernel)" << endl;
+	if (n <= 16) {
+		cout << "Risk function from row to column:" << endl;
+		for (int t = 0; t < n; t++) { cout << "\t" << graph.names[t]; }
+		cout << endl;
+		for (int s = 0; s < n; s++) {
+			cout << graph.names[s];
+			for (int t = 0; t < n; t++) { cout << "\t" << A.value(s, t); }
+			cout << endl;
+		}
 	}
-	sort(aux.begin(), aux.end(), priority);
-	for (int i = 0; i < aux.size(); i++) { Q.push(aux[i]); }
+	double largest = 0;
+	for (int s = 0; s < n; s++) {
+		sssp_result S = dijkstra <noisy_or>(graph, s);
+		for (int t = 0; t < n; t++) { largest = max(largest, fabs(A.value(s, t) - S.value[t])); }
+	}
+	cout << "Largest difference from Dijkstra: " << largest << endl;
+	return largest <= 1e-9;
+}
+
+/*** follow_updates() reads batches of changes from a file, separated by blank lines:
+	a b prob     new probability of the edge between a and b
+	v p          new parameter p of node v
+and after every batch repairs the risks from the source, checked against a new Dijkstra
+search. It returns the number of batches whose risks differ. ***/
+int follow_updates(const csr_graph& graph, int source, int target, const string& path) {
+	ifstream file(path);
+	if (!file) { cout << "Error: cannot open " << path << "." << endl; return 1; }
+	dynamic_sssp <noisy_or> D(graph, source);
+	string line;
+	int batch = 0, changes = 0, failed = 0;
+	bool more = true;
+	while (more) {
+		more = (bool)getline(file, line);
+		field words[4];
+		int k = more ? split_words(line, words, 4) : 0;
+		if (k > 0 && words[0][0] == '#') continue;
+		if (k == 0) {
+			if (changes == 0) continue;
+// end of a batch: repair, then compare with a search from scratch
+			int repaired;
+			{
+				TRACE_PHASE("repair");
+				repaired = D.update();
+			}
+			sssp_result S;
+			{
+				TRACE_PHASE("recompute");
+				S = dijkstra <noisy_or>(D.graph(), source);
+			}
+			int different = 0;
+			for (int v = 0; v < graph.num_vertices(); v++) { if (D.value(v) != S.value[v]) different++; }
+			cout << "Batch " << ++batch << ": " << changes << " changes, " << repaired << " nodes settled again (" << S.settled.size()
+				<< " from scratch)" << endl;
+			cout << "\tRisk function at " << graph.names[target] << ": " << D.value(target);
+			cout << (different == 0 ? " (same as Dijkstra)" : " (DIFFERENT from Dijkstra)") << endl;
+			if (different) failed++;
+			changes = 0;
+			continue;
+		}
+		int a = graph.find_vertex(words[0]);
+		double w;
+		if (a == -1 || (k != 2 && k != 3) || !parse_double(words[k - 1], w)) { cout << "Error: bad change: " << line << "." << endl; return failed + 1; }
+		if (k == 3) {
+			int b = graph.find_vertex(words[1]);
+			if (b == -1 || !D.set_arc(a, b, w) || !D.set_arc(b, a, w)) { cout << "Error: no edge " << words[0] << " " << words[1] << "." << endl; return failed + 1; }
+		}
+		else {
+			try { D.set_node(a, w); }
+			catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return failed + 1; }
+		}
+		changes++;
+	}
+	return failed;
 }
 
 int main(int argc, char** argv) {
 
-	_CrtSetReportMode(_CRT_ERROR, _CRTDBG_MODE_DEBUG);
-
-// build the nodes
-	struct node* a = new node;		a->name = "a";		a->p = 0.3;		a->risk = a->p;			a->visited = true;
-	struct node* b = new node;		b->name = "b";		b->p = 0.4;
-	struct node* c = new node;		c->name = "c";		c->p = 0.6;
-	struct node* d = new node;		d->name = "d";		d->p = 0.4;
-	struct node* e = new node;		e->name = "e";		e->p = 0.4;
-	struct node* f = new node;		f->name = "f";		f->p = 0.7;
-	struct node* g = new node;		g->name = "g";		g->p = 0.5;
-	struct node* h = new node;		h->name = "h";		h->p = 0.6;
-	struct node* i = new node;		i->name = "i";		i->p = 0.4;
-	struct node* j = new node;		j->name = "j";		j->p = 0.4;
-	struct node* k = new node;		k->name = "k";		k->p = 0.6;
-	
+// arguments: [graph source target] [--all] [--threads=N] [--search=dijkstra|bidirectional|astar] [--landmarks=K] [--landmarks-file=path] [--updates=path]
+//            [--all-pairs] [--kernel=auto|scalar|avx2|avx512] [--order=none|bfs|rcm|degree]
+	vector <string> args;
+	bool all = false, all_pairs = false;
+	unsigned threads = 0;
+	string search = "dijkstra", landmarks_file, updates, kernel = "auto", order = "none";
+	int count = 8;
+	for (int n = 1; n < argc; n++) {
+		string arg = argv[n];
+		if (arg == "--all") all = true;
+		else if (arg == "--all-pairs") all_pairs = true;
+		else if (arg.compare(0, 9, "--kernel=") == 0) kernel = arg.substr(9);
+		else if (arg.compare(0, 10, "--threads=") == 0) threads = atoi(arg.c_str() + 10);
+		else if (arg.compare(0, 9, "--search=") == 0) search = arg.substr(9);
+		else if (arg.compare(0, 12, "--landmarks=") == 0) count = atoi(arg.c_str() + 12);
+		else if (arg.compare(0, 17, "--landmarks-file=") == 0) landmarks_file = arg.substr(17);
+		else if (arg.compare(0, 10, "--updates=") == 0) updates = arg.substr(10);
+		else if (arg.compare(0, 8, "--order=") == 0) order = arg.substr(8);
+		else args.push_back(arg);
+	}
+
+	csr_graph graph;
+	int source, target;
+	if (args.size() >= 3) {
+// read the undirected edges and the parameters p from an edge list or a snapshot
+		TRACE_PHASE("load");
+		try { graph = open_graph(args[0], false); }
+		catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
+		source = graph.find_vertex(args[1]);
+		target = graph.find_vertex(args[2]);
+		if (source == -1 || target == -1) { cout << "Invalid source or target." << endl; return 1; }
+	}
+	else {
+// build the nodes and their parameter p
+		graph_builder G;
+		int a = G.add_vertex("a", 0.3);
+		int b = G.add_vertex("b", 0.4);
+		int c = G.add_vertex("c", 0.6);
+		int d = G.add_vertex("d", 0.4);
+		int e = G.add_vertex("e", 0.4);
+		int f = G.add_vertex("f", 0.7);
+		int g = G.add_vertex("g", 0.5);
+		int h = G.add_vertex("h", 0.6);
+		int i = G.add_vertex("i", 0.4);
+		int j = G.add_vertex("j", 0.4);
+		int k = G.add_vertex("k", 0.6);
+
 // build the edges
-	add_edge(a, b, 0.3);	add_edge(a, j, 0.5);	add_edge(b, j, 0.4);	add_edge(b, c, 0.2);
-	add_edge(c, j, 0.2);	add_edge(j, k, 0.4);	add_edge(j, i, 0.3);	add_edge(c, k, 0.4);
-	add_edge(c, d, 0.3);	add_edge(i, k, 0.3);	add_edge(k, d, 0.5);	add_edge(i, h, 0.4);
-	add_edge(k, h, 0.4);	add_edge(k, e, 0.5);	add_edge(d, e, 0.2);	add_edge(h, e, 0.3);
-	add_edge(h, g, 0.3);	add_edge(e, g, 0.6);	add_edge(h, f, 0.6);	add_edge(e, f, 0.4);
-	add_edge(f, g, 0.2);
-
-// dump all nodes into a queue
-	queue <struct node*> Q;
-	Q.push(a); Q.push(b); Q.push(c); Q.push(d); Q.push(e); Q.push(f);
-	Q.push(g); Q.push(h); Q.push(i); Q.push(j); Q.push(k);
-	sortQueue(Q);
-
-// empty queue to dump visited nodes
-	queue <struct node*> S;
-
-/*** DIJKSTRA ALGORITHM ***/
-	node* currNode = NULL;
-	node* succ = NULL;
-	vector <pair<struct node*, double>>::iterator it;
-	double aux;
-	double new_risk;
-	while (!Q.empty()) {
-		currNode = Q.front();       // extract node of lowest risk function
-		currNode->visited = true;   // set it to "visited"
-		Q.pop();                    // delete it from Q
-		S.push(currNode);           // put it in S
-		if (currNode->risk >= 1) { cout << "Sorry, you are dead" << endl; break; }
-		if (currNode == g) { cout << "Congratulations, you have made it out alive." << endl; break; }
-		// check all adjacent nodes, but only if they are not in Q
-		for (it = (currNode->adjList).begin(); it < (currNode->adjList).end(); it++) {
-			succ = it->first;
-			aux = it->second + succ->p - it->second * succ->p;
-			new_risk = currNode->risk + aux - currNode->risk * aux;
-			if ((succ->risk > new_risk) && (succ->visited == false)) succ->risk = new_risk;
+		add_edge(G, a, b, 0.3);	add_edge(G, a, j, 0.5);	add_edge(G, b, j, 0.4);	add_edge(G, b, c, 0.2);
+		add_edge(G, c, j, 0.2);	add_edge(G, j, k, 0.4);	add_edge(G, j, i, 0.3);	add_edge(G, c, k, 0.4);
+		add_edge(G, c, d, 0.3);	add_edge(G, i, k, 0.3);	add_edge(G, k, d, 0.5);	add_edge(G, i, h, 0.4);
+		add_edge(G, k, h, 0.4);	add_edge(G, k, e, 0.5);	add_edge(G, d, e, 0.2);	add_edge(G, h, e, 0.3);
+		add_edge(G, h, g, 0.3);	add_edge(G, e, g, 0.6);	add_edge(G, h, f, 0.6);	add_edge(G, e, f, 0.4);
+		add_edge(G, f, g, 0.2);
+		graph = G.build(true);
+		source = a;
+		target = g;
+	}
+
+// renumber the nodes so that neighbours lie close in memory; names move with their nodes
+	try {
+		vertex_order o = parse_order(order);
+		if (o != vertex_order::none) {
+			TRACE_PHASE("reorder");
+			vertex_permutation P = order_vertices(graph, o);
+			graph = permute(graph, P);
+			source = P.new_id[source];
+			target = P.new_id[target];
 		}
-		sortQueue(Q);   // arrange nodes that are left in descending saf.function
 	}
+	catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
 
-// print the result
-	if (currNode == g) {
-		cout << "This has been your trip:\n";
-		while (!S.empty()) {
-			cout << "Position: " << S.front()->name << endl;
-			cout << "\tRisk function: " << S.front()->risk << endl;
-			S.pop();
+/*** WHOLE NETWORK: risk of every node, by parallel delta-stepping, checked against Dijkstra ***/
+	if (all) {
+		delta_stepping <noisy_or> D(graph, 0, threads);
+		vector <double> risk = D.run(source);
+		sssp_result S = dijkstra <noisy_or>(graph, source);
+		int different = 0;
+		for (int v = 0; v < graph.num_vertices(); v++) {
+			if (graph.num_vertices() <= 100) cout << "Node: " << graph.names[v] << "\tRisk function: " << risk[v] << endl;
+			if (risk[v] != S.value[v]) different++;
+		}
+		cout << "Nodes whose risk differs from sequential Dijkstra: " << different << " of " << graph.num_vertices() << endl;
+		return different == 0 ? 0 : 1;
+	}
+
+/*** EVERY PAIR OF NODES: vectorized Floyd-Warshall on the costs -log(1 - risk) ***/
+	if (all_pairs) {
+		try { return risk_matrix(graph, threads, parse_kernel(kernel)) ? 0 : 1; }
+		catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
+	}
+
+/*** CHANGING NETWORK: risks repaired after every batch of new probabilities ***/
+	if (!updates.empty()) return follow_updates(graph, source, target, updates) == 0 ? 0 : 1;
+
+/*** POINT-TO-POINT SEARCH: bidirectional, or A* with landmark bounds, checked against Dijkstra ***/
+	if (search != "dijkstra") {
+		path_result P;
+		if (search == "bidirectional") {
+			bidirectional_search <noisy_or> B(graph);
+			P = B.run(source, target);
 		}
+		else if (search == "astar") {
+			try {
+				landmarks <noisy_or> L = open_landmarks <noisy_or>(graph, landmarks_file, count);
+				P = astar <noisy_or>(graph, source, target, landmark_bound <noisy_or>(L, target));
+			}
+			catch (exception& e) { cout << "Error: " << e.what() << "." << endl; return 1; }
+		}
+		else { cout << "Error: unknown search " << search << "." << endl; return 1; }
+		sssp_result S = dijkstra <noisy_or>(graph, source, target);
+		if (!P.reached) { cout << "No path from " << graph.names[source] << " to " << graph.names[target] << "." << endl; return S.reached ? 1 : 0; }
+		cout << "Path:";
+		for (int n = 0; n < P.path.size(); n++) { cout << " " << graph.names[P.path[n]]; }
+		cout << endl << "\tRisk function: " << P.value << (P.value == S.value[target] ? " (same as Dijkstra)" : " (DIFFERENT from Dijkstra)") << endl;
+		cout << "Settled vertices: " << P.settled << " (Dijkstra: " << S.settled.size() << ")" << endl;
+		return P.value == S.value[target] ? 0 : 1;
+	}
+
+/*** DIJKSTRA ALGORITHM: minimize the noisy-OR risk of edges and visited nodes ***/
+// the parameter p of every node is folded into the edges that enter it, once, so that the
+// search relaxes the edges of a node together on one effective probability each
+	csr_graph folded;
+	{
+		TRACE_PHASE("fold");
+		folded = fold_node_weights <noisy_or>(graph);
+	}
+	double p_source = graph.has_node_weights() ? graph.node_weight[source] : noisy_or::one();
+	sssp_result S;
+	{
+		TRACE_PHASE("dijkstra");
+		S = dijkstra_folded <noisy_or>(folded, p_source, source, target);
 	}
 
-	else if (Q.empty()) {
+// print the result
+	if (!S.reached) {
+		cout << "Sorry, you are dead" << endl;
 		cout << "Error: Dijkstra algorithm did not find an exit." << endl;
 		exit(EXIT_FAILURE);
 	}
-
-// free memory
-	delete a;	delete b;	delete c;	delete d;	delete e;	delete f;	delete g;
-	delete h;	delete i;	delete j;	delete k;
+	cout << "Congratulations, you have made it out alive." << endl;
+	cout << "This has been your trip:\n";
+	for (int n = 0; n < S.settled.size(); n++) {
+		cout << "Position: " << graph.names[S.settled[n]] << endl;
+		cout << "\tRisk function: " << S.value[S.settled[n]] << endl;
+	}
 
 	return 0;
 }